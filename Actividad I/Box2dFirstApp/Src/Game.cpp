@@ -7,6 +7,7 @@ Game::Game(int ancho, int alto, std::string titulo)
 {
     // Inicializacin de la ventana y configuracin de propiedades
     wnd = new RenderWindow(VideoMode(ancho, alto), titulo);
+    title = titulo;
     wnd->setVisible(true);
     fps = 60;
     wnd->setFramerateLimit(fps);
@@ -25,6 +26,7 @@ void Game::Loop()
         CheckCollitions(); // Comprobar colisiones
         UpdatePhysics(); // Actualizar la simulacin fsica
         DrawGame(); // Dibujar el juego
+        UpdateTitle(); // Mostrar los golpes en el ttulo
         wnd->display(); // Mostrar la ventana
     }
 }
@@ -32,9 +34,9 @@ void Game::Loop()
 // Actualizacin de la simulacin fsica
 void Game::UpdatePhysics()
 {
-    phyWorld->Step(frameTime, 8, 8); // Simular el mundo fsico
+    phyWorld->Step(frameTime, 8, 3); // Simular el mundo fsico
     phyWorld->ClearForces(); // Limpiar las fuerzas aplicadas a los cuerpos
-    phyWorld->DebugDraw(); // Dibujar el mundo fsico para depuracin
+    debugRender->DrawWorld(phyWorld); // Dibujar lo visible del mundo fsico para depuracin
 }
 
 // Dibujo de los elementos del juego
@@ -49,7 +51,8 @@ void Game::DrawGame()
     // Dibujar el cuerpo (cuadrado)
     sf::RectangleShape squareShape(sf::Vector2f(20, 20));
     squareShape.setFillColor(sf::Color::White);
-    squareShape.setPosition(controlBody->GetPosition().x - 10, controlBody->GetPosition().y - 10);
+    b2Vec2 controlPos = WorldUnits::ToUnits(controlBody->GetPosition());
+    squareShape.setPosition(controlPos.x - 10, controlPos.y - 10);
     wnd->draw(squareShape);
 }
 
@@ -65,20 +68,40 @@ void Game::DoEvents()
             wnd->close(); // Cerrar la ventana si se presiona el botn de cerrar
             break;
         case Event::MouseButtonPressed:
-            // Crear un cuerpo dinmico triangular en la posicin del ratn
-            b2Body* body = Box2DHelper::CreateTriangularDynamicBody(phyWorld, b2Vec2(0.0f, 0.0f), 10.0f, 1.0f, 4.0f, 0.1f);
             // Transformar las coordenadas segn la vista activa
             Vector2f pos = wnd->mapPixelToCoords(Vector2i(evt.mouseButton.x, evt.mouseButton.y));
-            body->SetTransform(b2Vec2(pos.x, pos.y), 0.0f);
+            if (evt.mouseButton.button == Mouse::Right)
+            {
+                // Crear una estrella cncava (sale de la cach despus de la primera)
+                Box2DHelper::CreatePolyDynamicBody(phyWorld, polygonCache, &starOutline[0], (int)starOutline.size(), 1.0f, 0.5f, 0.1f, LAYER_DEFAULT, b2Vec2(pos.x, pos.y));
+                break;
+            }
+            // Crear un cuerpo dinmico triangular en la posicin del ratn
+            b2Body* body = Box2DHelper::CreateTriangularDynamicBody(phyWorld, b2Vec2(0.0f, 0.0f), 10.0f, 1.0f, 4.0f, 0.1f);
+            body->SetTransform(WorldUnits::ToMeters(b2Vec2(pos.x, pos.y)), 0.0f);
             break;
         }
     }
 }
 
-// Comprobacin de colisiones (a implementar ms adelante)
+// Comprobacin de colisiones: procesa en bloque los eventos del ltimo Step
 void Game::CheckCollitions()
 {
-    // Implementacin de la comprobacin de colisiones
+    // Vaciar la cola de contactos contando los golpes nuevos
+    contactQueue->Drain(0xFFFF, [this](const ContactEvent& evt)
+    {
+        if (evt.type == CONTACT_HIT)
+            impactCount++;
+    });
+}
+
+// Muestra los golpes en el ttulo; solo se cambia cuando hay golpes nuevos
+void Game::UpdateTitle()
+{
+    if (impactCount == shownImpactCount)
+        return;
+    shownImpactCount = impactCount;
+    wnd->setTitle(title + " - golpes: " + std::to_string(impactCount));
 }
 
 // Configuracin de la vista del juego
@@ -95,20 +118,35 @@ void Game::SetZoom()
 void Game::InitPhysics()
 {
     // Inicializar el mundo fsico con la gravedad por defecto
-    phyWorld = new b2World(b2Vec2(0.0f, 9.8f));
+    phyWorld = new b2World(WorldUnits::ToMeters(b2Vec2(0.0f, 9.8f)));
 
     // Crear un renderer de debug para visualizar el mundo fsico
     debugRender = new SFMLRenderer(wnd);
     debugRender->SetFlags(UINT_MAX);
     phyWorld->SetDebugDraw(debugRender);
 
+    // Instalar la cola de eventos de contacto (se vaca en CheckCollitions)
+    contactQueue = new ContactQueue(4096);
+    phyWorld->SetContactListener(contactQueue);
+    phyWorld->SetDestructionListener(contactQueue);
+    impactCount = 0;
+    shownImpactCount = 0;
+
     // Crear el suelo del mundo fsico
     b2Body* groundBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 100, 10);
-    groundBody->SetTransform(b2Vec2(50.0f, 100.0f), 0.0f);
+    groundBody->SetTransform(WorldUnits::ToMeters(b2Vec2(50.0f, 100.0f)), 0.0f);
 
     // Crear el cuadrado
     controlBody = Box2DHelper::CreateRectangularDynamicBody(phyWorld, 20, 20, 1.0f, 0.5f, 0.1f);
-    controlBody->SetTransform(b2Vec2(50.0f, 50.0f), 0.0f);
+    controlBody->SetTransform(WorldUnits::ToMeters(b2Vec2(50.0f, 50.0f)), 0.0f);
+
+    // Contorno de la estrella de 5 puntas (10 vrtices, ms que b2_maxPolygonVertices)
+    for (int i = 0; i < 10; i++)
+    {
+        float radius = (i % 2 == 0) ? 8.0f : 3.5f;
+        float angle = i * b2_pi / 5.0f - b2_pi / 2.0f;
+        starOutline.push_back(b2Vec2(radius * cosf(angle), radius * sinf(angle)));
+    }
 }
 
 // Destructor de la clase
@@ -2,6 +2,8 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
 #include "SFMLRenderer.h"
+#include "ContactQueue.h"
+#include "PolygonCache.h"
 #include <list>
 
 using namespace sf;
@@ -17,6 +19,12 @@ private:
 	// Objetos de box2d
 	b2World *phyWorld;
 	SFMLRenderer *debugRender;
+	ContactQueue *contactQueue;
+
+	// Golpes registrados por la cola de contactos, se muestran en el ttulo
+	int impactCount;
+	int shownImpactCount;
+	std::string title;
 
 	//tiempo de frame
 	float frameTime;
@@ -25,6 +33,10 @@ private:
 	// Cuerpo de box2d
 	b2Body* controlBody;
 
+	// Piezas convexas de los contornos que se crean con el click derecho
+	PolygonCache polygonCache;
+	std::vector<b2Vec2> starOutline;
+
 public:
 
 	// Constructores, destructores e inicializadores
@@ -40,5 +52,6 @@ public:
 	void UpdatePhysics();
 	void DoEvents();
 	void SetZoom();
+	void UpdateTitle();
 };
 
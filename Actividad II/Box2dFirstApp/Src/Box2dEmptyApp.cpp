@@ -1,4 +1,5 @@
 #include "Game.h" // Incluye el archivo de encabezado de la clase Game
+#include "Sweep.h" // Barrido de parmetros sin ventana
 #include <tchar.h> // Incluye la biblioteca de caracteres de Windows
 
 using namespace sf; // Espacio de nombres para la biblioteca SFML
@@ -8,6 +9,13 @@ using namespace sf; // Espacio de nombres para la biblioteca SFML
 // Funcin principal del programa
 int _tmain(int argc, _TCHAR* argv[])
 {
+    // Con --sweep se corre el barrido de parmetros sin abrir la ventana
+    if (argc > 1 && _tcscmp(argv[1], _T("--sweep")) == 0)
+    {
+        Sweep::Run(600);
+        return 0;
+    }
+
     // Crear el objeto de la clase Game
     Game* Juego;
     Juego = new Game(800, 600, "MAVII");
@@ -0,0 +1,138 @@
+//-----------------------------------------------------
+//Capas de colisin con nombre. Una matriz simtrica
+//indica qu capas pueden chocar entre s y se compila
+//en los categoryBits/maskBits del b2Filter de cada
+//fixture, as box2d descarta los pares que nunca
+//interactan al crear el par, antes del narrow phase
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+
+// Capas disponibles (cada una ocupa un bit de categoryBits)
+enum CollisionLayer
+{
+	LAYER_DEFAULT = 0,	// mismo bit que el filtro por defecto de box2d
+	LAYER_STATIC,		// suelo, techo, paredes y obstculos
+	LAYER_PLAYER,		// cuerpo de control
+	LAYER_PROJECTILE,	// proyectiles
+	LAYER_DYNAMIC,		// resto de los cuerpos dinmicos
+	LAYER_COUNT
+};
+
+class CollisionLayers
+{
+private:
+	// Matriz con los presets cargados desde su construccin
+	struct PresetMatrix
+	{
+		uint16 rows[LAYER_COUNT];
+
+		PresetMatrix() { SetPresets(rows); }
+	};
+
+	//-------------------------------------------------------------
+	// Matriz de colisin: el bit j de la fila i indica si la capa i
+	// choca con la capa j. La construye el primer uso; C++11 garantiza
+	// que un static local se inicializa una sola vez aunque lo pidan
+	// varios hilos a la vez (los hilos del JobSystem arman escenas)
+	//-------------------------------------------------------------
+	static uint16* Matrix()
+	{
+		static PresetMatrix matrix;
+		return matrix.rows;
+	}
+
+	//-------------------------------------------------------------
+	// Presets: todo choca con todo salvo los proyectiles entre s
+	// y los proyectiles con el cuerpo de control que los dispara
+	//-------------------------------------------------------------
+	static void SetPresets(uint16* matrix)
+	{
+		uint16 all = (uint16)((1 << LAYER_COUNT) - 1);
+		for (int i = 0; i < LAYER_COUNT; i++)
+			matrix[i] = all;
+
+		SetBit(matrix, LAYER_PROJECTILE, LAYER_PROJECTILE, false);
+		SetBit(matrix, LAYER_PROJECTILE, LAYER_PLAYER, false);
+	}
+
+	static void SetBit(uint16* matrix, CollisionLayer a, CollisionLayer b, bool canCollide)
+	{
+		if (canCollide)
+		{
+			matrix[a] |= GetCategoryBits(b);
+			matrix[b] |= GetCategoryBits(a);
+		}
+		else
+		{
+			matrix[a] &= (uint16)~GetCategoryBits(b);
+			matrix[b] &= (uint16)~GetCategoryBits(a);
+		}
+	}
+
+public:
+	//-------------------------------------------------------------
+	// Bit de categora de una capa
+	//-------------------------------------------------------------
+	static uint16 GetCategoryBits(CollisionLayer layer)
+	{
+		return (uint16)(1 << layer);
+	}
+
+	//-------------------------------------------------------------
+	// Mscara con todas las capas con las que choca la capa dada
+	//-------------------------------------------------------------
+	static uint16 GetMaskBits(CollisionLayer layer)
+	{
+		return Matrix()[layer];
+	}
+
+	//-------------------------------------------------------------
+	// Indica si dos capas pueden chocar
+	//-------------------------------------------------------------
+	static bool CanCollide(CollisionLayer a, CollisionLayer b)
+	{
+		return (Matrix()[a] & GetCategoryBits(b)) != 0;
+	}
+
+	//-------------------------------------------------------------
+	// Cambia la matriz de forma simtrica. Afecta a los filtros que
+	// se generen despus; los fixtures existentes se actualizan con
+	// ApplyLayer
+	//-------------------------------------------------------------
+	static void SetCanCollide(CollisionLayer a, CollisionLayer b, bool canCollide)
+	{
+		SetBit(Matrix(), a, b, canCollide);
+	}
+
+	//-------------------------------------------------------------
+	// Vuelve la matriz a los presets
+	//-------------------------------------------------------------
+	static void ResetPresets()
+	{
+		SetPresets(Matrix());
+	}
+
+	//-------------------------------------------------------------
+	// Filtro de box2d compilado para una capa
+	//-------------------------------------------------------------
+	static b2Filter GetFilter(CollisionLayer layer)
+	{
+		b2Filter filter;
+		filter.categoryBits = GetCategoryBits(layer);
+		filter.maskBits = GetMaskBits(layer);
+		filter.groupIndex = 0;
+		return filter;
+	}
+
+	//-------------------------------------------------------------
+	// Asigna la capa a todos los fixtures de un body
+	//-------------------------------------------------------------
+	static void ApplyLayer(b2Body* body, CollisionLayer layer)
+	{
+		b2Filter filter = GetFilter(layer);
+		for (b2Fixture* f = body->GetFixtureList(); f; f = f->GetNext())
+			f->SetFilterData(filter);
+	}
+};
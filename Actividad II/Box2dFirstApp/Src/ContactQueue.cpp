@@ -0,0 +1,133 @@
+#include "ContactQueue.h"
+
+// Constructor: reserva todo el buffer de una sola vez
+ContactQueue::ContactQueue(int capacity)
+{
+    this->capacity = capacity > 0 ? capacity : 1;
+    events.resize(this->capacity);
+    head = 0;
+    count = 0;
+    dropped = 0;
+    impulseThreshold = b2_maxFloat; // Sin eventos de impulso hasta que se configure un umbral
+}
+
+// Destructor de la clase ContactQueue
+ContactQueue::~ContactQueue(void)
+{ }
+
+// Reserva el siguiente lugar libre del buffer y copia los datos comunes del contacto
+ContactEvent* ContactQueue::Push(ContactEventType type, b2Contact* contact)
+{
+    if (count == capacity)
+    {
+        ++dropped; // Buffer lleno: se descarta el evento ms nuevo
+        return nullptr;
+    }
+
+    ContactEvent* evt = &events[(head + count) % capacity];
+    ++count;
+
+    b2Fixture* fixtureA = contact->GetFixtureA();
+    b2Fixture* fixtureB = contact->GetFixtureB();
+    evt->type = type;
+    evt->fixtureA = fixtureA;
+    evt->fixtureB = fixtureB;
+    evt->categoryA = fixtureA->GetFilterData().categoryBits;
+    evt->categoryB = fixtureB->GetFilterData().categoryBits;
+    evt->point.SetZero();
+    evt->normal.SetZero();
+    evt->speed = 0.0f;
+    evt->impulse = 0.0f;
+    return evt;
+}
+
+// Copia el primer punto y la normal del manifold en coordenadas de mundo
+void ContactQueue::FillWorldManifold(ContactEvent* evt, b2Contact* contact)
+{
+    b2WorldManifold worldManifold;
+    contact->GetWorldManifold(&worldManifold);
+    evt->point = worldManifold.points[0];
+    evt->normal = worldManifold.normal;
+}
+
+// Dos fixtures empiezan a tocarse
+void ContactQueue::BeginContact(b2Contact* contact)
+{
+    Push(CONTACT_BEGIN, contact);
+}
+
+// Dos fixtures dejan de tocarse (tambin se llama al destruir un body)
+void ContactQueue::EndContact(b2Contact* contact)
+{
+    Push(CONTACT_END, contact);
+}
+
+// Antes de resolver: registra un golpe cuando aparece un punto de contacto nuevo
+void ContactQueue::PreSolve(b2Contact* contact, const b2Manifold* oldManifold)
+{
+    b2PointState state1[b2_maxManifoldPoints], state2[b2_maxManifoldPoints];
+    b2GetPointStates(state1, state2, oldManifold, contact->GetManifold());
+    if (state2[0] != b2_addState)
+        return;
+
+    ContactEvent* evt = Push(CONTACT_HIT, contact);
+    if (evt == nullptr)
+        return;
+
+    FillWorldManifold(evt, contact);
+    b2Body* bodyA = contact->GetFixtureA()->GetBody();
+    b2Body* bodyB = contact->GetFixtureB()->GetBody();
+    b2Vec2 vA = bodyA->GetLinearVelocityFromWorldPoint(evt->point);
+    b2Vec2 vB = bodyB->GetLinearVelocityFromWorldPoint(evt->point);
+    evt->speed = -b2Dot(vB - vA, evt->normal); // Positiva cuando los cuerpos se acercan
+}
+
+// Despus de resolver: registra el impulso normal si supera el umbral
+void ContactQueue::PostSolve(b2Contact* contact, const b2ContactImpulse* impulse)
+{
+    float maxImpulse = 0.0f;
+    for (int32 i = 0; i < impulse->count; ++i)
+        maxImpulse = b2Max(maxImpulse, impulse->normalImpulses[i]);
+    if (maxImpulse < impulseThreshold)
+        return;
+
+    ContactEvent* evt = Push(CONTACT_IMPULSE, contact);
+    if (evt == nullptr)
+        return;
+
+    FillWorldManifold(evt, contact);
+    evt->impulse = maxImpulse;
+}
+
+// Los joints no se guardan en la cola
+void ContactQueue::SayGoodbye(b2Joint* joint)
+{
+    B2_NOT_USED(joint);
+}
+
+// Un fixture se destruye con su body: se invalidan los eventos que lo referencian
+void ContactQueue::SayGoodbye(b2Fixture* fixture)
+{
+    for (int i = 0; i < count; ++i)
+    {
+        ContactEvent& evt = events[(head + i) % capacity];
+        if (evt.fixtureA == fixture || evt.fixtureB == fixture)
+        {
+            evt.fixtureA = nullptr;
+            evt.fixtureB = nullptr;
+        }
+    }
+}
+
+// Configura el impulso mnimo para registrar eventos de post-solve
+void ContactQueue::SetImpulseThreshold(float threshold)
+{
+    impulseThreshold = threshold;
+}
+
+// Vaca la cola sin entregar eventos
+void ContactQueue::Clear()
+{
+    head = 0;
+    count = 0;
+}
@@ -0,0 +1,100 @@
+//-----------------------------------------------------
+//Cola de eventos de contacto. Se instala como listener
+//del mundo de box2d y copia los datos de cada contacto
+//(comienzo, fin, golpe e impulso) en un buffer circular
+//preasignado mientras corre Step. Game::CheckCollitions
+//la vaca en bloque despus del paso, sin reservar
+//memoria ni ejecutar lgica dentro de los callbacks
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <vector>
+
+// Tipos de evento que registra la cola
+enum ContactEventType
+{
+	CONTACT_BEGIN,		// los fixtures empiezan a tocarse
+	CONTACT_END,		// los fixtures dejan de tocarse
+	CONTACT_HIT,		// aparece un punto de contacto nuevo (pre-solve)
+	CONTACT_IMPULSE		// impulso normal por encima del umbral (post-solve)
+};
+
+// Copia de los datos de un contacto, vlida fuera del Step
+struct ContactEvent
+{
+	ContactEventType type;
+	b2Fixture* fixtureA;	// nullptr si el fixture se destruy antes de vaciar la cola
+	b2Fixture* fixtureB;
+	uint16 categoryA;
+	uint16 categoryB;
+	b2Vec2 point;			// punto de contacto en coordenadas de mundo (golpe e impulso)
+	b2Vec2 normal;			// normal de A hacia B (golpe e impulso)
+	float speed;			// velocidad de aproximacin (golpe)
+	float impulse;			// impulso normal mximo (impulso)
+};
+
+class ContactQueue : public b2ContactListener, public b2DestructionListener
+{
+private:
+	// Buffer circular de tamao fijo
+	std::vector<ContactEvent> events;
+	int capacity;
+	int head;
+	int count;
+
+	// Eventos descartados por falta de lugar
+	int dropped;
+
+	// Impulso mnimo para registrar un evento de post-solve
+	float impulseThreshold;
+
+	ContactEvent* Push(ContactEventType type, b2Contact* contact);
+	void FillWorldManifold(ContactEvent* evt, b2Contact* contact);
+
+public:
+	ContactQueue(int capacity);
+	~ContactQueue(void);
+
+	// Callbacks de b2ContactListener (se llaman dentro de Step)
+	void BeginContact(b2Contact* contact) override;
+	void EndContact(b2Contact* contact) override;
+	void PreSolve(b2Contact* contact, const b2Manifold* oldManifold) override;
+	void PostSolve(b2Contact* contact, const b2ContactImpulse* impulse) override;
+
+	// Callbacks de b2DestructionListener: invalidan los eventos pendientes
+	// que apuntan a fixtures destruidos junto con su body
+	void SayGoodbye(b2Joint* joint) override;
+	void SayGoodbye(b2Fixture* fixture) override;
+
+	void SetImpulseThreshold(float threshold);
+	int GetCount() const { return count; }
+	int GetCapacity() const { return capacity; }
+	int GetDropped() const { return dropped; }
+
+	// Recorre los eventos pendientes en orden, llama a handler(const ContactEvent&)
+	// para los que involucran alguna categora de categoryMask y vaca la cola.
+	// Devuelve la cantidad de eventos entregados
+	template <typename Handler>
+	int Drain(uint16 categoryMask, Handler handler);
+
+	void Clear();
+};
+
+template <typename Handler>
+int ContactQueue::Drain(uint16 categoryMask, Handler handler)
+{
+	int delivered = 0;
+	for (int i = 0; i < count; ++i)
+	{
+		const ContactEvent& evt = events[(head + i) % capacity];
+		if (evt.fixtureA == nullptr || evt.fixtureB == nullptr)
+			continue;
+		if (((evt.categoryA | evt.categoryB) & categoryMask) == 0)
+			continue;
+		handler(evt);
+		++delivered;
+	}
+	Clear();
+	return delivered;
+}
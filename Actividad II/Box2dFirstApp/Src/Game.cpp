@@ -7,6 +7,7 @@ Game::Game(int ancho, int alto, std::string titulo)
 {
     // Inicializacin de la ventana y configuracin de propiedades
     wnd = new RenderWindow(VideoMode(ancho, alto), titulo);
+    title = titulo;
     wnd->setVisible(true);
     fps = 60;
     wnd->setFramerateLimit(fps);
@@ -25,6 +26,7 @@ void Game::Loop()
         CheckCollitions(); // Comprobar colisiones
         UpdatePhysics(); // Actualizar la simulacin fsica
         DrawGame(); // Dibujar el juego
+        UpdateTitle(); // Mostrar los golpes en el ttulo
         wnd->display(); // Mostrar la ventana
     }
 }
@@ -32,9 +34,9 @@ void Game::Loop()
 // Actualizacin de la simulacin fsica
 void Game::UpdatePhysics()
 {
-    phyWorld->Step(frameTime, 8, 8); // Simular el mundo fsico
+    phyWorld->Step(frameTime, 8, 3); // Simular el mundo fsico
     phyWorld->ClearForces(); // Limpiar las fuerzas aplicadas a los cuerpos
-    phyWorld->DebugDraw(); // Dibujar el mundo fsico para depuracin
+    debugRender->DrawWorld(phyWorld); // Dibujar lo visible del mundo fsico para depuracin
 }
 
 // Dibujo de los elementos del juego
@@ -66,7 +68,8 @@ void Game::DrawGame()
     // Dibujar el cuerpo de control (crculo)
     sf::CircleShape controlShape(5);
     controlShape.setFillColor(sf::Color::Blue);
-    controlShape.setPosition(controlBody->GetPosition().x - 5, controlBody->GetPosition().y - 5);
+    b2Vec2 controlPos = WorldUnits::ToUnits(controlBody->GetPosition());
+    controlShape.setPosition(controlPos.x - 5, controlPos.y - 5);
     wnd->draw(controlShape);
 }
 
@@ -85,10 +88,24 @@ void Game::DoEvents()
     }
 }
 
-// Comprobacin de colisiones (a implementar ms adelante)
+// Comprobacin de colisiones: procesa en bloque los eventos del ltimo Step
 void Game::CheckCollitions()
 {
-    // Implementacin de la comprobacin de colisiones
+    // Vaciar la cola de contactos contando los golpes nuevos
+    contactQueue->Drain(0xFFFF, [this](const ContactEvent& evt)
+    {
+        if (evt.type == CONTACT_HIT)
+            impactCount++;
+    });
+}
+
+// Muestra los golpes en el ttulo; solo se cambia cuando hay golpes nuevos
+void Game::UpdateTitle()
+{
+    if (impactCount == shownImpactCount)
+        return;
+    shownImpactCount = impactCount;
+    wnd->setTitle(title + " - golpes: " + std::to_string(impactCount));
 }
 
 // Configuracin de la vista del juego
@@ -104,32 +121,83 @@ void Game::SetZoom()
 // Inicializacin del motor de fsica y los cuerpos del mundo fsico
 void Game::InitPhysics()
 {
-    // Inicializar el mundo fsico con la gravedad por defecto
-    phyWorld = new b2World(b2Vec2(0.0f, 9.8f));
+    // Inicializar el mundo fsico (la gravedad la define BuildScene)
+    phyWorld = new b2World(b2Vec2(0.0f, 0.0f));
 
     // Crear un renderer de debug para visualizar el mundo fsico
     debugRender = new SFMLRenderer(wnd);
     debugRender->SetFlags(UINT_MAX);
     phyWorld->SetDebugDraw(debugRender);
 
-    // Crear el suelo y las paredes estticas del mundo fsico
-    b2Body* groundBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 100, 10);
-    groundBody->SetTransform(b2Vec2(50.0f, 100.0f), 0.0f);
-    groundBody->GetFixtureList()->SetFriction(0.1f);  //menos friccin, ms rebote
+    // Instalar la cola de eventos de contacto (se vaca en CheckCollitions)
+    contactQueue = new ContactQueue(4096);
+    phyWorld->SetContactListener(contactQueue);
+    phyWorld->SetDestructionListener(contactQueue);
+    impactCount = 0;
+    shownImpactCount = 0;
 
-    b2Body* upWallBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 100, 10);
-    upWallBody->SetTransform(b2Vec2(250.0f, 50.0f), 0.0f);
+    // Crear la escena (la misma que usa el barrido de parmetros)
+    controlBody = BuildScene(phyWorld, DefaultParams());
+}
 
-    b2Body* leftWallBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 10, 100);
-    leftWallBody->SetTransform(b2Vec2(0.0f, 50.0f), 0.0f);
+// Valores con los que corre el juego
+SweepParams Game::DefaultParams()
+{
+    SweepParams params;
+    params.gravity = 9.8f;
+    params.friction = 0.1f;       // friccin del suelo
+    params.restitution = 1.0f;    // restitucin de la pelota
+    params.velocityIterations = 8;
+    params.positionIterations = 3;
+    return params;
+}
 
-    b2Body* rightWallBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 10, 100);
-    rightWallBody->SetTransform(b2Vec2(100.0f, 50.0f), 0.0f);
+// Combinaciones del barrido: restitucin de la pelota, friccin del suelo,
+// gravedad e iteraciones del solver (11 x 6 x 3 x 2 = 396 mundos)
+std::vector<SweepParams> Game::SweepGrid()
+{
+    const float frictions[] = { 0.0f, 0.1f, 0.2f, 0.3f, 0.5f, 0.8f };
+    const float gravities[] = { 4.9f, 9.8f, 19.6f };
+    const int positionIterations[] = { 3, 8 };
+
+    std::vector<SweepParams> grid;
+    for (int r = 0; r <= 10; r++)
+        for (float friction : frictions)
+            for (float gravity : gravities)
+                for (int iterations : positionIterations)
+                {
+                    SweepParams params;
+                    params.gravity = gravity;
+                    params.friction = friction;
+                    params.restitution = r * 0.1f;
+                    params.velocityIterations = 8;
+                    params.positionIterations = iterations;
+                    grid.push_back(params);
+                }
+    return grid;
+}
+
+// Creacin de la gravedad, las paredes y la pelota en el mundo dado.
+// Devuelve la pelota
+b2Body* Game::BuildScene(b2World* world, const SweepParams& params, StaticGeometryStats* stats)
+{
+    world->SetGravity(WorldUnits::ToMeters(b2Vec2(0.0f, params.gravity)));
+
+    // El suelo y las paredes van en un solo body esttico. El suelo solo se junta
+    // con las paredes en un contorno cuando el barrido le da su misma friccin
+    StaticGeometryBuilder builder;
+    builder.AddRectangle(b2Vec2(50.0f, 100.0f), 100, 10, params.friction);  //menos friccin, ms rebote
+    builder.AddRectangle(b2Vec2(250.0f, 50.0f), 100, 10);
+    builder.AddRectangle(b2Vec2(0.0f, 50.0f), 10, 100);
+    builder.AddRectangle(b2Vec2(100.0f, 50.0f), 10, 100);
+    builder.Build(world, STATIC_MERGE_CHAIN, LAYER_STATIC, stats);
 
     // Crear el circulo 
-    controlBody = Box2DHelper::CreateCircularDynamicBody(phyWorld, 5, 1.0f, 0.5, 1.0f);
-    controlBody->SetTransform(b2Vec2(10.0f, 50.0f), 0.0f);
-    controlBody->SetLinearVelocity(b2Vec2(10.0f, -10.0f)); //movimiento inicial en diagonal
+    b2Body* ball = Box2DHelper::CreateCircularDynamicBody(world, 5, 1.0f, 0.5, params.restitution);
+    ball->SetTransform(WorldUnits::ToMeters(b2Vec2(10.0f, 50.0f)), 0.0f);
+    ball->SetLinearVelocity(WorldUnits::ToMeters(b2Vec2(10.0f, -10.0f))); //movimiento inicial en diagonal
+
+    return ball;
 }
 
 // Destructor de la clase
@@ -2,6 +2,9 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
 #include "SFMLRenderer.h"
+#include "ContactQueue.h"
+#include "Sweep.h"
+#include "StaticGeometryBuilder.h"
 #include <list>
 
 using namespace sf;
@@ -17,6 +20,12 @@ private:
 	// Objetos de box2d
 	b2World *phyWorld;
 	SFMLRenderer *debugRender;
+	ContactQueue *contactQueue;
+
+	// Golpes registrados por la cola de contactos, se muestran en el ttulo
+	int impactCount;
+	int shownImpactCount;
+	std::string title;
 
 	//tiempo de frame
 	float frameTime;
@@ -34,11 +43,17 @@ public:
 	~Game(void);
 	void InitPhysics();
 
+	// Escena y rango de parmetros compartidos con el barrido (no dependen de la ventana)
+	static SweepParams DefaultParams();
+	static std::vector<SweepParams> SweepGrid();
+	static b2Body* BuildScene(b2World* world, const SweepParams& params, StaticGeometryStats* stats = nullptr);
+
 	// Main game loop
 	void Loop();
 	void DrawGame();
 	void UpdatePhysics();
 	void DoEvents();
 	void SetZoom();
+	void UpdateTitle();
 };
 
@@ -0,0 +1,317 @@
+#include "StaticGeometryBuilder.h"
+#include "WorldUnits.h"
+#include <algorithm>
+#include <iostream>
+#include <map>
+
+void StaticGeometryStats::Print() const
+{
+    std::cout << rectangles << " rectangulos estaticos: "
+        << bodiesBefore << " bodies, " << fixturesBefore << " fixtures, " << proxiesBefore << " proxies -> "
+        << bodiesAfter << " body, " << fixturesAfter << " fixtures (" << chains << " contornos), "
+        << proxiesAfter << " proxies" << std::endl;
+}
+
+void StaticGeometryBuilder::AddRectangle(b2Vec2 center, float sizeX, float sizeY, float friction, float restitution)
+{
+    Rect rect;
+    rect.minX = center.x - sizeX / 2.0f;
+    rect.maxX = center.x + sizeX / 2.0f;
+    rect.minY = center.y - sizeY / 2.0f;
+    rect.maxY = center.y + sizeY / 2.0f;
+    rect.friction = friction;
+    rect.restitution = restitution;
+    rects.push_back(rect);
+}
+
+int StaticGeometryBuilder::Grid::At(int i, int j) const
+{
+    if (i < 0 || j < 0 || i >= width() || j >= height())
+        return -1;
+    return cells[j * width() + i];
+}
+
+bool StaticGeometryBuilder::Grid::ColumnCovered(int i, int j0, int j1, int component) const
+{
+    for (int j = j0; j < j1; j++)
+        if (At(i, j) != component)
+            return false;
+    return true;
+}
+
+bool StaticGeometryBuilder::Grid::RowCovered(int j, int i0, int i1, int component) const
+{
+    for (int i = i0; i < i1; i++)
+        if (At(i, j) != component)
+            return false;
+    return true;
+}
+
+// Bordes de los rectngulos como coordenadas de la grilla, celdas cubiertas
+// y componentes conectadas por lados (relleno por inundacin)
+void StaticGeometryBuilder::BuildGrid(const std::vector<Rect>& group, Grid& grid, int& components)
+{
+    for (const Rect& r : group)
+    {
+        grid.xs.push_back(r.minX);
+        grid.xs.push_back(r.maxX);
+        grid.ys.push_back(r.minY);
+        grid.ys.push_back(r.maxY);
+    }
+    std::sort(grid.xs.begin(), grid.xs.end());
+    grid.xs.erase(std::unique(grid.xs.begin(), grid.xs.end()), grid.xs.end());
+    std::sort(grid.ys.begin(), grid.ys.end());
+    grid.ys.erase(std::unique(grid.ys.begin(), grid.ys.end()), grid.ys.end());
+
+    int w = grid.width();
+    int h = grid.height();
+    std::vector<bool> covered(w * h, false);
+    for (const Rect& r : group)
+    {
+        int i0 = (int)(std::lower_bound(grid.xs.begin(), grid.xs.end(), r.minX) - grid.xs.begin());
+        int i1 = (int)(std::lower_bound(grid.xs.begin(), grid.xs.end(), r.maxX) - grid.xs.begin());
+        int j0 = (int)(std::lower_bound(grid.ys.begin(), grid.ys.end(), r.minY) - grid.ys.begin());
+        int j1 = (int)(std::lower_bound(grid.ys.begin(), grid.ys.end(), r.maxY) - grid.ys.begin());
+        for (int j = j0; j < j1; j++)
+            for (int i = i0; i < i1; i++)
+                covered[j * w + i] = true;
+    }
+
+    grid.cells.assign(w * h, -1);
+    components = 0;
+    std::vector<int> stack;
+    for (int start = 0; start < w * h; start++)
+    {
+        if (!covered[start] || grid.cells[start] >= 0)
+            continue;
+
+        grid.cells[start] = components;
+        stack.push_back(start);
+        while (!stack.empty())
+        {
+            int c = stack.back();
+            stack.pop_back();
+            int i = c % w;
+            int j = c / w;
+            const int di[] = { 1, -1, 0, 0 };
+            const int dj[] = { 0, 0, 1, -1 };
+            for (int k = 0; k < 4; k++)
+            {
+                int ni = i + di[k];
+                int nj = j + dj[k];
+                if (ni < 0 || nj < 0 || ni >= w || nj >= h)
+                    continue;
+                int n = nj * w + ni;
+                if (covered[n] && grid.cells[n] < 0)
+                {
+                    grid.cells[n] = components;
+                    stack.push_back(n);
+                }
+            }
+        }
+        components++;
+    }
+}
+
+void StaticGeometryBuilder::AddBox(b2Body* body, float minX, float minY, float maxX, float maxY, b2FixtureDef& def, StaticGeometryStats& stats)
+{
+    b2Vec2 center = WorldUnits::ToMeters(b2Vec2((minX + maxX) / 2.0f, (minY + maxY) / 2.0f));
+    b2PolygonShape box;
+    box.SetAsBox(WorldUnits::ToMeters(maxX - minX) / 2.0f, WorldUnits::ToMeters(maxY - minY) / 2.0f, center, 0.0f);
+    def.shape = &box;
+    body->CreateFixture(&def);
+    stats.fixturesAfter++;
+    stats.proxiesAfter++;
+}
+
+// Unin voraz: desde cada celda que ninguna caja cubre todava se crece un
+// rectngulo de celdas del grupo en las cuatro direcciones (primero en x y
+// primero en y, se queda el de ms rea). Las cajas pueden pisarse, as que
+// p. ej. el suelo y las dos paredes vuelven a ser tres cajas
+void StaticGeometryBuilder::AddBoxes(b2Body* body, const Grid& grid, int component, b2FixtureDef& def, StaticGeometryStats& stats)
+{
+    int w = grid.width();
+    int h = grid.height();
+    std::vector<bool> used(w * h, false);
+    for (int j = 0; j < h; j++)
+    {
+        for (int i = 0; i < w; i++)
+        {
+            if (grid.At(i, j) != component || used[j * w + i])
+                continue;
+
+            int best[4] = { i, i + 1, j, j + 1 };
+            float bestArea = -1.0f;
+            for (int xFirst = 0; xFirst < 2; xFirst++)
+            {
+                int r[4] = { i, i + 1, j, j + 1 };
+                for (int pass = 0; pass < 2; pass++)
+                {
+                    if ((pass == 0) == (xFirst == 1))
+                    {
+                        while (grid.ColumnCovered(r[1], r[2], r[3], component))
+                            r[1]++;
+                        while (grid.ColumnCovered(r[0] - 1, r[2], r[3], component))
+                            r[0]--;
+                    }
+                    else
+                    {
+                        while (grid.RowCovered(r[3], r[0], r[1], component))
+                            r[3]++;
+                        while (grid.RowCovered(r[2] - 1, r[0], r[1], component))
+                            r[2]--;
+                    }
+                }
+
+                float area = (grid.xs[r[1]] - grid.xs[r[0]]) * (grid.ys[r[3]] - grid.ys[r[2]]);
+                if (area > bestArea)
+                {
+                    bestArea = area;
+                    for (int k = 0; k < 4; k++)
+                        best[k] = r[k];
+                }
+            }
+
+            for (int jj = best[2]; jj < best[3]; jj++)
+                for (int ii = best[0]; ii < best[1]; ii++)
+                    used[jj * w + ii] = true;
+            AddBox(body, grid.xs[best[0]], grid.ys[best[2]], grid.xs[best[1]], grid.ys[best[3]], def, stats);
+        }
+    }
+}
+
+// Contorno del grupo: los lados de celda que dan a una celda vaca, orientados
+// con el slido a la izquierda (antihorario en coordenadas de box2d), que es
+// el sentido en que los lados de una cadena chocan desde afuera.
+// Cada lazo cerrado (borde exterior o hueco) se vuelve un b2ChainShape
+void StaticGeometryBuilder::AddOutline(b2Body* body, const Grid& grid, int component, b2FixtureDef& def, StaticGeometryStats& stats)
+{
+    typedef std::pair<int, int> Corner;
+    std::multimap<Corner, Corner> edges;
+    for (int j = 0; j < grid.height(); j++)
+    {
+        for (int i = 0; i < grid.width(); i++)
+        {
+            if (grid.At(i, j) != component)
+                continue;
+            if (grid.At(i, j - 1) != component)
+                edges.insert(std::make_pair(Corner(i, j), Corner(i + 1, j)));
+            if (grid.At(i + 1, j) != component)
+                edges.insert(std::make_pair(Corner(i + 1, j), Corner(i + 1, j + 1)));
+            if (grid.At(i, j + 1) != component)
+                edges.insert(std::make_pair(Corner(i + 1, j + 1), Corner(i, j + 1)));
+            if (grid.At(i - 1, j) != component)
+                edges.insert(std::make_pair(Corner(i, j + 1), Corner(i, j)));
+        }
+    }
+
+    while (!edges.empty())
+    {
+        // Recorrer un lazo sacando los lados usados
+        std::vector<Corner> loop;
+        Corner start = edges.begin()->first;
+        Corner current = start;
+        do
+        {
+            auto next = edges.find(current);
+            if (next == edges.end())
+                break;
+            loop.push_back(current);
+            current = next->second;
+            edges.erase(next);
+        } while (current != start);
+
+        // Solo quedan las esquinas: se quitan los vrtices en medio de un lado recto
+        std::vector<b2Vec2> vertices;
+        int n = (int)loop.size();
+        for (int k = 0; k < n; k++)
+        {
+            const Corner& prev = loop[(k + n - 1) % n];
+            const Corner& here = loop[k];
+            const Corner& next = loop[(k + 1) % n];
+            int cross = (here.first - prev.first) * (next.second - here.second) - (here.second - prev.second) * (next.first - here.first);
+            if (cross != 0)
+                vertices.push_back(WorldUnits::ToMeters(b2Vec2(grid.xs[here.first], grid.ys[here.second])));
+        }
+        if (vertices.size() < 3)
+            continue;
+
+        b2ChainShape chain;
+        chain.CreateLoop(&vertices[0], (int32)vertices.size());
+        def.shape = &chain;
+        body->CreateFixture(&def);
+        stats.fixturesAfter++;
+        stats.proxiesAfter += chain.GetChildCount();
+        stats.chains++;
+    }
+}
+
+b2Body* StaticGeometryBuilder::Build(b2World* world, StaticMergeMode mode, CollisionLayer layer, StaticGeometryStats* stats)
+{
+    StaticGeometryStats counts;
+    counts.rectangles = (int)rects.size();
+    counts.bodiesBefore = counts.rectangles;
+    counts.fixturesBefore = counts.rectangles;
+    counts.proxiesBefore = counts.rectangles;
+    counts.bodiesAfter = 1;
+    counts.fixturesAfter = 0;
+    counts.proxiesAfter = 0;
+    counts.chains = 0;
+
+    b2BodyDef bodyDef;
+    bodyDef.type = b2_staticBody;
+    b2Body* body = world->CreateBody(&bodyDef);
+
+    // Solo se juntan los rectngulos del mismo material
+    std::vector<bool> done(rects.size(), false);
+    for (size_t first = 0; first < rects.size(); first++)
+    {
+        if (done[first])
+            continue;
+
+        std::vector<Rect> group;
+        for (size_t k = first; k < rects.size(); k++)
+        {
+            if (!done[k] && rects[k].friction == rects[first].friction && rects[k].restitution == rects[first].restitution)
+            {
+                group.push_back(rects[k]);
+                done[k] = true;
+            }
+        }
+
+        b2FixtureDef def;
+        def.friction = rects[first].friction;
+        def.restitution = rects[first].restitution;
+        def.filter = CollisionLayers::GetFilter(layer);
+
+        Grid grid;
+        int components;
+        BuildGrid(group, grid, components);
+        for (int c = 0; c < components; c++)
+        {
+            // Un grupo que es un solo rectngulo queda como caja (colisiona de los dos lados)
+            int cellsX0 = grid.width(), cellsX1 = -1, cellsY0 = grid.height(), cellsY1 = -1, cellCount = 0;
+            for (int j = 0; j < grid.height(); j++)
+                for (int i = 0; i < grid.width(); i++)
+                    if (grid.At(i, j) == c)
+                    {
+                        cellsX0 = b2Min(cellsX0, i);
+                        cellsX1 = b2Max(cellsX1, i);
+                        cellsY0 = b2Min(cellsY0, j);
+                        cellsY1 = b2Max(cellsY1, j);
+                        cellCount++;
+                    }
+            bool single = cellCount == (cellsX1 - cellsX0 + 1) * (cellsY1 - cellsY0 + 1);
+
+            if (mode == STATIC_MERGE_BOXES || single)
+                AddBoxes(body, grid, c, def, counts);
+            else
+                AddOutline(body, grid, c, def, counts);
+        }
+    }
+
+    rects.clear();
+    if (stats != nullptr)
+        *stats = counts;
+    return body;
+}
@@ -0,0 +1,50 @@
+//-----------------------------------------------------
+//Barrido de parmetros fsicos sin ventana. Crea un
+//b2World independiente por combinacin de parmetros
+//(Game::SweepGrid) con la escena de la actividad
+//(Game::BuildScene), los simula en paralelo sobre el
+//JobSystem y muestra por consola una tabla con el tiempo
+//de asentamiento, la posicin final y la energa del
+//cuerpo de control de cada mundo
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <vector>
+
+// Parmetros de un mundo del barrido
+struct SweepParams
+{
+	float gravity;				// gravedad vertical, en unidades de render/s
+	float friction;				// friccin de la superficie principal de la escena
+	float restitution;			// restitucin de la superficie principal de la escena
+	int velocityIterations;
+	int positionIterations;
+};
+
+// Mtricas de un mundo del barrido
+struct SweepResult
+{
+	SweepParams params;
+	float settleTime;			// segundos hasta que el cuerpo queda quieto (-1 si no se asienta)
+	b2Vec2 finalPosition;		// en unidades de render
+	float initialEnergy;		// energa mecnica del cuerpo, en J (metros y kg de box2d)
+	float finalEnergy;
+	float runMs;				// tiempo de simulacin del mundo
+};
+
+class Sweep
+{
+public:
+	// Simula todas las combinaciones de Game::SweepGrid durante steps pasos de 1/60 s
+	static void Run(int steps);
+
+	// Simula un mundo con los parmetros dados (se llama desde los hilos del JobSystem)
+	static SweepResult RunWorld(const SweepParams& params, int steps);
+
+	// Energa cintica ms potencial del body
+	static float Energy(const b2Body* body, const b2Vec2& gravity);
+
+	static void PrintHeader();
+	static void PrintRow(const SweepResult& result);
+};
@@ -1,4 +1,5 @@
 #include "Game.h" // Incluye el archivo de encabezado de la clase Game
+#include "SessionHost.h" // Sesiones sin ventana en un mundo compartido
 #include <tchar.h> // Incluye la biblioteca de caracteres de Windows
 
 using namespace sf; // Espacio de nombres para la biblioteca SFML
@@ -6,6 +7,13 @@ using namespace sf; // Espacio de nombres para la biblioteca SFML
 // Funcin principal del programa
 int _tmain(int argc, _TCHAR* argv[])
 {
+    // Con --sessions se compara el host de sesiones contra un mundo por sesin
+    if (argc > 1 && _tcscmp(argv[1], _T("--sessions")) == 0)
+    {
+        SessionHost::RunBenchmark(argc > 2 ? _ttoi(argv[2]) : 200, 600);
+        return 0;
+    }
+
     // Crear el objeto de la clase Game
     Game* Juego;
     Juego = new Game(800, 600, "MAVII");
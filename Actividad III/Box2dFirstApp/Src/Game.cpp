@@ -7,6 +7,7 @@ Game::Game(int ancho, int alto, std::string titulo)
 {
     // Inicializacin de la ventana y configuracin de propiedades
     wnd = new RenderWindow(VideoMode(ancho, alto), titulo);
+    title = titulo;
     wnd->setVisible(true);
     fps = 60;
     wnd->setFramerateLimit(fps);
@@ -25,6 +26,7 @@ void Game::Loop()
         CheckCollitions(); // Comprobar colisiones
         UpdatePhysics(); // Actualizar la simulacin fsica
         DrawGame(); // Dibujar el juego
+        UpdateTitle(); // Mostrar los golpes en el ttulo
         wnd->display(); // Mostrar la ventana
     }
 }
@@ -32,9 +34,9 @@ void Game::Loop()
 // Actualizacin de la simulacin fsica
 void Game::UpdatePhysics()
 {
-    phyWorld->Step(frameTime, 8, 8); // Simular el mundo fsico
+    phyWorld->Step(frameTime, 8, 3); // Simular el mundo fsico
     phyWorld->ClearForces(); // Limpiar las fuerzas aplicadas a los cuerpos
-    phyWorld->DebugDraw(); // Dibujar el mundo fsico para depuracin
+    debugRender->DrawWorld(phyWorld); // Dibujar lo visible del mundo fsico para depuracin
 }
 
 // Dibujo de los elementos del juego
@@ -66,7 +68,8 @@ void Game::DrawGame()
     // Dibujar el cuerpo de control (crculo)
     sf::CircleShape controlShape(5);
     controlShape.setFillColor(sf::Color::Blue);
-    controlShape.setPosition(controlBody->GetPosition().x - 5, controlBody->GetPosition().y - 5);
+    b2Vec2 controlPos = WorldUnits::ToUnits(controlBody->GetPosition());
+    controlShape.setPosition(controlPos.x - 5, controlPos.y - 5);
     wnd->draw(controlShape);
 
     //dibujamos los obstaculos
@@ -102,10 +105,24 @@ void Game::DoEvents()
     }
 }
 
-// Comprobacin de colisiones (a implementar ms adelante)
+// Comprobacin de colisiones: procesa en bloque los eventos del ltimo Step
 void Game::CheckCollitions()
 {
-    // Implementacin de la comprobacin de colisiones
+    // Vaciar la cola de contactos contando los golpes nuevos
+    contactQueue->Drain(0xFFFF, [this](const ContactEvent& evt)
+    {
+        if (evt.type == CONTACT_HIT)
+            impactCount++;
+    });
+}
+
+// Muestra los golpes en el ttulo; solo se cambia cuando hay golpes nuevos
+void Game::UpdateTitle()
+{
+    if (impactCount == shownImpactCount)
+        return;
+    shownImpactCount = impactCount;
+    wnd->setTitle(title + " - golpes: " + std::to_string(impactCount));
 }
 
 // Configuracin de la vista del juego
@@ -121,46 +138,56 @@ void Game::SetZoom()
 // Inicializacin del motor de fsica y los cuerpos del mundo fsico
 void Game::InitPhysics()
 {
-    // Inicializar el mundo fsico con la gravedad por defecto
-    phyWorld = new b2World(b2Vec2(0.0f, 9.8f));
+    // Inicializar el mundo fsico (la gravedad la define BuildStatic)
+    phyWorld = new b2World(b2Vec2(0.0f, 0.0f));
 
     // Crear un renderer de debug para visualizar el mundo fsico
     debugRender = new SFMLRenderer(wnd);
     debugRender->SetFlags(UINT_MAX);
     phyWorld->SetDebugDraw(debugRender);
 
-    // Crear el suelo y las paredes estticas del mundo fsico
-    b2Body* groundBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 100, 10);
-    groundBody->SetTransform(b2Vec2(50.0f, 100.0f), 0.0f);
-    groundBody->GetFixtureList()->SetFriction(0.1f);  //menos friccin, ms rebote
-
-    b2Body* upWallBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 100, 10);
-    upWallBody->SetTransform(b2Vec2(250.0f, 50.0f), 0.0f);
+    // Instalar la cola de eventos de contacto (se vaca en CheckCollitions)
+    contactQueue = new ContactQueue(4096);
+    phyWorld->SetContactListener(contactQueue);
+    phyWorld->SetDestructionListener(contactQueue);
+    impactCount = 0;
+    shownImpactCount = 0;
 
-    b2Body* leftWallBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 10, 100);
-    leftWallBody->SetTransform(b2Vec2(0.0f, 50.0f), 0.0f);
-    leftWallBody->GetFixtureList()->SetFriction(0.1f);
+    // Crear la escena (la misma que usan las sesiones del SessionHost)
+    BuildStatic(phyWorld);
+    controlBody = BuildDynamic(phyWorld);
+}
 
-    b2Body* rightWallBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 10, 100);
-    rightWallBody->SetTransform(b2Vec2(100.0f, 50.0f), 0.0f);
-    rightWallBody->GetFixtureList()->SetFriction(0.1f);
+// Creacin de la gravedad, el suelo, las paredes y los obstculos en el mundo dado.
+// Devuelve el body esttico que los contiene
+b2Body* Game::BuildStatic(b2World* world, StaticMergeMode mode, StaticGeometryStats* stats)
+{
+    // Gravedad por defecto
+    world->SetGravity(WorldUnits::ToMeters(b2Vec2(0.0f, 9.8f)));
+
+    // El suelo, las paredes y los obstculos se juntan en un solo body esttico:
+    // el suelo y las paredes laterales quedan como un contorno sin las uniones
+    // donde antes se tocaban tres bodies
+    StaticGeometryBuilder builder;
+    builder.AddRectangle(b2Vec2(50.0f, 100.0f), 100, 10, 0.1f);  //menos friccin, ms rebote
+    builder.AddRectangle(b2Vec2(250.0f, 50.0f), 100, 10);
+    builder.AddRectangle(b2Vec2(0.0f, 50.0f), 10, 100, 0.1f);
+    builder.AddRectangle(b2Vec2(100.0f, 50.0f), 10, 100, 0.1f);
+    builder.AddRectangle(b2Vec2(20.0f, 60.0f), 10, 10, 0.1f);
+    builder.AddRectangle(b2Vec2(50.0f, 70.0f), 10, 10, 0.1f);
+    builder.AddRectangle(b2Vec2(75.0f, 35.0f), 10, 10, 0.1f);
+    return builder.Build(world, mode, LAYER_STATIC, stats);
+}
 
+// Creacin del crculo de control en el mundo dado
+b2Body* Game::BuildDynamic(b2World* world)
+{
     // Crear el circulo 
-    controlBody = Box2DHelper::CreateCircularDynamicBody(phyWorld, 5, 1.0f, 0.5, 1.0f);
-    controlBody->SetTransform(b2Vec2(10.0f, 50.0f), 0.0f);
-    controlBody->SetLinearVelocity(b2Vec2(10.0f, -10.0f)); //movimiento inicial en diagonal
-
-    b2Body* ObstacleBody1 = Box2DHelper::CreateRectangularStaticBody(phyWorld, 10, 10);
-    ObstacleBody1->SetTransform(b2Vec2(20.0f, 60.0f), 0.0f);
-    ObstacleBody1->GetFixtureList()->SetFriction(0.1f);
-
-    b2Body* ObstacleBody2 = Box2DHelper::CreateRectangularStaticBody(phyWorld, 10, 10);
-    ObstacleBody2->SetTransform(b2Vec2(50.0f, 70.0f), 0.0f);
-    ObstacleBody2->GetFixtureList()->SetFriction(0.1f);
+    b2Body* ball = Box2DHelper::CreateCircularDynamicBody(world, 5, 1.0f, 0.5, 1.0f);
+    ball->SetTransform(WorldUnits::ToMeters(b2Vec2(10.0f, 50.0f)), 0.0f);
+    ball->SetLinearVelocity(WorldUnits::ToMeters(b2Vec2(10.0f, -10.0f))); //movimiento inicial en diagonal
 
-    b2Body* ObstacleBody3 = Box2DHelper::CreateRectangularStaticBody(phyWorld, 10, 10);
-    ObstacleBody3->SetTransform(b2Vec2(75.0f, 35.0f), 0.0f);
-    ObstacleBody3->GetFixtureList()->SetFriction(0.1f);
+    return ball;
 }
 // Destructor de la clase
 
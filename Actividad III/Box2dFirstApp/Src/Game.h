@@ -2,6 +2,8 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
 #include "SFMLRenderer.h"
+#include "ContactQueue.h"
+#include "StaticGeometryBuilder.h"
 #include <list>
 
 using namespace sf;
@@ -17,6 +19,12 @@ private:
 	// Objetos de box2d
 	b2World *phyWorld;
 	SFMLRenderer *debugRender;
+	ContactQueue *contactQueue;
+
+	// Golpes registrados por la cola de contactos, se muestran en el ttulo
+	int impactCount;
+	int shownImpactCount;
+	std::string title;
 
 	//tiempo de frame
 	float frameTime;
@@ -34,11 +42,16 @@ public:
 	~Game(void);
 	void InitPhysics();
 
+	// Escena separada en la parte esttica (compartida por todas las sesiones del SessionHost) y la dinmica
+	static b2Body* BuildStatic(b2World* world, StaticMergeMode mode = STATIC_MERGE_CHAIN, StaticGeometryStats* stats = nullptr);
+	static b2Body* BuildDynamic(b2World* world);
+
 	// Main game loop
 	void Loop();
 	void DrawGame();
 	void UpdatePhysics();
 	void DoEvents();
 	void SetZoom();
+	void UpdateTitle();
 };
 
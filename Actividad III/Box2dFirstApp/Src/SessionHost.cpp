@@ -0,0 +1,206 @@
+#include "SessionHost.h"
+#include "Game.h"
+#include "WorldUnits.h"
+#include <iostream>
+
+// Nmero de sesin guardado en el fixture (0 = geometra compartida)
+uintptr_t SessionFilter::GetSessionTag(b2Fixture* fixture)
+{
+    return fixture->GetUserData().pointer;
+}
+
+// La geometra compartida choca con todas las sesiones; dos fixtures de
+// sesiones distintas nunca generan un b2Contact
+bool SessionFilter::ShouldCollide(b2Fixture* fixtureA, b2Fixture* fixtureB)
+{
+    calls++;
+    uintptr_t tagA = GetSessionTag(fixtureA);
+    uintptr_t tagB = GetSessionTag(fixtureB);
+    if (tagA != 0 && tagB != 0 && tagA != tagB)
+    {
+        rejected++;
+        return false;
+    }
+
+    return b2ContactFilter::ShouldCollide(fixtureA, fixtureB);
+}
+
+// Constructor: crea el mundo y la nica copia de la escena esttica (marca 0)
+SessionHost::SessionHost(SessionLayout layout)
+{
+    this->layout = layout;
+    world = new b2World(b2Vec2(0.0f, 0.0f));
+    world->SetContactFilter(&filter);
+    staticFixtures = 0;
+    for (b2Fixture* f = Game::BuildStatic(world)->GetFixtureList(); f; f = f->GetNext())
+        staticFixtures++;
+    staticProxies = world->GetProxyCount();
+
+    activeCount = 0;
+}
+
+// Destructor: el mundo se lleva todas las sesiones
+SessionHost::~SessionHost(void)
+{
+    delete world;
+}
+
+// Crea el contenido dinmico y lo marca con el nmero de la sesin
+int SessionHost::CreateSession()
+{
+    int id;
+    if (!freeIds.empty())
+    {
+        id = freeIds.back();
+        freeIds.pop_back();
+    }
+    else
+    {
+        id = (int)sessions.size();
+        sessions.push_back(Session());
+    }
+
+    Session& session = sessions[id];
+    session.active = true;
+    session.bodies.clear();
+
+    // Solo se corre el contenido dinmico; la escena es la misma para todas
+    b2Vec2 offset = layout == SESSION_SPREAD ? WorldUnits::ToMeters(GetSpawnOffset(id)) : b2Vec2(0.0f, 0.0f);
+    b2Body* control = Game::BuildDynamic(world);
+    control->SetTransform(control->GetPosition() + offset, 0.0f);
+    session.bodies.push_back(control);
+
+    for (b2Body* body : session.bodies)
+        for (b2Fixture* f = body->GetFixtureList(); f; f = f->GetNext())
+            f->GetUserData().pointer = (uintptr_t)id + 1;
+
+    activeCount++;
+    return id;
+}
+
+// Grilla de lugares de arranque dentro de la caja de la escena (entre las paredes
+// en x 5 y 95, sobre el suelo en y 95), separados un dimetro del crculo de control.
+// Con ms sesiones que lugares se repiten y los pares cruzados los descarta el filtro
+b2Vec2 SessionHost::GetSpawnOffset(int id)
+{
+    const int SpawnColumns = 8;
+    const int SpawnRows = 5;
+    int slot = id % (SpawnColumns * SpawnRows);
+    return b2Vec2(10.0f * (slot % SpawnColumns), -10.0f * (slot / SpawnColumns));
+}
+
+// Destruye solo los bodies de la sesin; el nmero queda libre para reusar
+void SessionHost::DestroySession(int id)
+{
+    Session& session = sessions[id];
+    if (!session.active)
+        return;
+
+    for (b2Body* body : session.bodies)
+        world->DestroyBody(body);
+    session.bodies.clear();
+    session.active = false;
+    freeIds.push_back(id);
+    activeCount--;
+}
+
+void SessionHost::Step(float timeStep, int velocityIterations, int positionIterations)
+{
+    world->Step(timeStep, velocityIterations, positionIterations);
+    world->ClearForces();
+}
+
+// Mismas sesiones en un host compartido y en un mundo por sesin
+void SessionHost::RunBenchmark(int sessionCount, int steps)
+{
+    const float timeStep = 1.0f / 60.0f;
+
+    // Velocidad inicial distinta por sesin para que no se muevan todas juntas
+    unsigned int seed = 12345;
+    std::vector<b2Vec2> velocities(sessionCount);
+    for (b2Vec2& v : velocities)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        float vx = (float)((seed >> 16) % 41) - 20.0f;
+        seed = seed * 1664525u + 1013904223u;
+        float vy = (float)((seed >> 16) % 41) - 20.0f;
+        v = WorldUnits::ToMeters(b2Vec2(vx, vy));
+    }
+
+    // Host compartido, con las sesiones repartidas en la escena y superpuestas
+    const SessionLayout layouts[] = { SESSION_SPREAD, SESSION_OVERLAPPED };
+    const char* names[] = { "host repartido", "host superpuesto" };
+    float hostMs[2];
+    float hostContacts[2];
+    float hostCalls[2];
+    float hostRejected[2];
+    int hostProxies[2];
+    int hostStatic[2];
+    int hostStaticProxies[2];
+    for (int l = 0; l < 2; l++)
+    {
+        SessionHost host(layouts[l]);
+        for (int i = 0; i < sessionCount; i++)
+            host.GetControl(host.CreateSession())->SetLinearVelocity(velocities[i]);
+
+        long long contacts = 0;
+        b2Timer timer;
+        for (int step = 0; step < steps; step++)
+        {
+            host.Step(timeStep, 8, 3);
+            contacts += host.GetWorld()->GetContactCount();
+        }
+        hostMs[l] = timer.GetMilliseconds();
+        hostContacts[l] = (float)contacts / steps;
+        hostCalls[l] = (float)host.GetFilter().calls / steps;
+        hostRejected[l] = (float)host.GetFilter().rejected / steps;
+        hostProxies[l] = host.GetWorld()->GetProxyCount();
+        hostStatic[l] = host.GetStaticFixtureCount();
+        hostStaticProxies[l] = host.GetStaticProxyCount();
+    }
+
+    // Un mundo por sesin, cada uno con su copia de la escena
+    // La primera copia cuenta la geometra esttica antes y despus de unirla
+    std::vector<b2World*> worlds(sessionCount);
+    StaticGeometryStats staticStats = {};
+    int separateProxies = 0;
+    for (int i = 0; i < sessionCount; i++)
+    {
+        worlds[i] = new b2World(b2Vec2(0.0f, 0.0f));
+        Game::BuildStatic(worlds[i], STATIC_MERGE_CHAIN, i == 0 ? &staticStats : nullptr);
+        Game::BuildDynamic(worlds[i])->SetLinearVelocity(velocities[i]);
+        separateProxies += worlds[i]->GetProxyCount();
+    }
+
+    long long separateContacts = 0;
+    b2Timer timer;
+    for (int step = 0; step < steps; step++)
+        for (b2World* w : worlds)
+        {
+            w->Step(timeStep, 8, 3);
+            w->ClearForces();
+            separateContacts += w->GetContactCount();
+        }
+    float separateMs = timer.GetMilliseconds();
+
+    for (b2World* w : worlds)
+        delete w;
+
+    // Pares del broadphase: contactos vivos por paso y llamadas al filtro desde AddPair.
+    // La escena esttica se cuenta una vez por host; lo que agrega cada sesin son sus proxies dinmicos
+    std::cout << sessionCount << " sesiones, " << steps << " pasos" << std::endl;
+    std::cout << "  escena: ";
+    staticStats.Print();
+    for (int l = 0; l < 2; l++)
+    {
+        std::cout << "  " << names[l] << ": " << hostMs[l] / steps << " ms/paso, "
+            << hostContacts[l] << " contactos/paso, " << hostCalls[l] << " ShouldCollide/paso ("
+            << hostRejected[l] << " entre sesiones), " << hostProxies[l] << " proxies (escena compartida: "
+            << hostStatic[l] << " fixtures y " << hostStaticProxies[l] << " proxies estaticos; por sesion: 0 estaticos y "
+            << (float)(hostProxies[l] - hostStaticProxies[l]) / b2Max(sessionCount, 1) << " proxies dinamicos), 1 b2World" << std::endl;
+    }
+    std::cout << "  mundos separados: " << separateMs / steps << " ms/paso, "
+        << (float)separateContacts / steps << " contactos/paso, "
+        << separateProxies << " proxies, " << sessionCount << " b2World de "
+        << sizeof(b2World) / 1024 << " KB cada uno sin contar bodies" << std::endl;
+}
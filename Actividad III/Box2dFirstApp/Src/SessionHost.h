@@ -0,0 +1,87 @@
+//-----------------------------------------------------
+//Servidor de sesiones sin ventana. Todas las sesiones
+//viven en un nico b2World sobre una sola copia de la
+//escena esttica (un body, ver StaticGeometryBuilder,
+//marcado con 0). Cada fixture dinmico lleva en su
+//userData el nmero de sesin y un b2ContactFilter
+//descarta los pares entre sesiones antes de que box2d
+//cree el b2Contact. La memoria por sesin es la de su
+//contenido dinmico, sin el b2World ni su stack
+//allocator ni otra copia de la escena. Para que los
+//pares cruzados lleguen poco al filtro, cada sesin
+//arranca en otro lugar de la escena (SESSION_SPREAD);
+//SESSION_OVERLAPPED las arranca a todas en el mismo
+//lugar, para medir el peor caso.
+//Para usar varios ncleos se crea un SessionHost por hilo
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <vector>
+
+// Lugar donde arranca el contenido dinmico de cada sesin
+enum SessionLayout
+{
+	SESSION_SPREAD,		// cada sesin en otro lugar de la escena compartida
+	SESSION_OVERLAPPED	// todas en el mismo lugar
+};
+
+// Filtro de contactos por sesin (userData.pointer = sesin + 1, 0 = compartido)
+class SessionFilter : public b2ContactFilter
+{
+public:
+	// Llamadas desde AddPair del broadphase y cuntas rechaz por ser de otra sesin
+	int calls;
+	int rejected;
+
+	SessionFilter() : calls(0), rejected(0) {}
+
+	bool ShouldCollide(b2Fixture* fixtureA, b2Fixture* fixtureB) override;
+
+	static uintptr_t GetSessionTag(b2Fixture* fixture);
+};
+
+class SessionHost
+{
+private:
+	// Bodies dinmicos de una sesin
+	struct Session
+	{
+		bool active;
+		std::vector<b2Body*> bodies;
+	};
+
+	b2World* world;
+	SessionFilter filter;
+	SessionLayout layout;
+	std::vector<Session> sessions;
+	std::vector<int> freeIds;
+	int activeCount;
+	int staticFixtures;
+	int staticProxies;
+
+public:
+	SessionHost(SessionLayout layout = SESSION_SPREAD);
+	~SessionHost(void);
+
+	// Crea una sesin con el contenido dinmico de la escena y devuelve su nmero
+	int CreateSession();
+	void DestroySession(int id);
+
+	// Avanza todas las sesiones a la vez
+	void Step(float timeStep, int velocityIterations, int positionIterations);
+
+	// Desplazamiento del contenido dinmico de la sesin (unidades de render)
+	static b2Vec2 GetSpawnOffset(int id);
+
+	// Cuerpo de control de la sesin (el primer body dinmico)
+	b2Body* GetControl(int id) const { return sessions[id].bodies.front(); }
+	int GetSessionCount() const { return activeCount; }
+	int GetStaticFixtureCount() const { return staticFixtures; }
+	int GetStaticProxyCount() const { return staticProxies; }
+	b2World* GetWorld() const { return world; }
+	const SessionFilter& GetFilter() const { return filter; }
+
+	// Compara un host con N sesiones (repartidas y superpuestas) contra N mundos separados
+	static void RunBenchmark(int sessionCount, int steps);
+};
@@ -0,0 +1,81 @@
+//-----------------------------------------------------
+//Junta los rectngulos estticos de una escena en un
+//solo body esttico. Los rectngulos con el mismo
+//material se pasan a una grilla comprimida con sus
+//bordes; cada grupo de celdas conectadas (rectngulos
+//que se tocan o se pisan) se convierte en un contorno
+//cerrado con b2ChainShape::CreateLoop, sin los lados
+//interiores donde antes se tocaban dos bodies, y los
+//rectngulos sueltos quedan como cajas. Con
+//STATIC_MERGE_BOXES los grupos se cubren con las cajas
+//que encuentra una unin voraz de celdas en lugar de
+//usar el contorno.
+//Build devuelve cuntos bodies, fixtures y proxies
+//haba antes (un body por rectngulo) y cuntos quedan
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <vector>
+#include "CollisionLayers.h"
+
+// Forma en que se juntan los rectngulos que se tocan
+enum StaticMergeMode
+{
+	STATIC_MERGE_CHAIN,		// un contorno b2ChainShape por grupo
+	STATIC_MERGE_BOXES		// cajas unidas por el algoritmo voraz
+};
+
+// Conteos antes y despus de juntar
+struct StaticGeometryStats
+{
+	int rectangles;
+	int bodiesBefore;
+	int fixturesBefore;
+	int proxiesBefore;
+	int bodiesAfter;
+	int fixturesAfter;
+	int proxiesAfter;		// un proxy por caja y uno por lado de cada contorno
+	int chains;
+
+	void Print() const;
+};
+
+class StaticGeometryBuilder
+{
+private:
+	// Rectngulo en unidades de render
+	struct Rect
+	{
+		float minX, minY, maxX, maxY;
+		float friction;
+		float restitution;
+	};
+	std::vector<Rect> rects;
+
+	// Grilla comprimida de un grupo de rectngulos del mismo material
+	struct Grid
+	{
+		std::vector<float> xs;
+		std::vector<float> ys;
+		std::vector<int> cells;		// componente de cada celda (-1 = vaca)
+		int width() const { return (int)xs.size() - 1; }
+		int height() const { return (int)ys.size() - 1; }
+		int At(int i, int j) const;
+		bool ColumnCovered(int i, int j0, int j1, int component) const;
+		bool RowCovered(int j, int i0, int i1, int component) const;
+	};
+
+	static void BuildGrid(const std::vector<Rect>& group, Grid& grid, int& components);
+	static void AddBoxes(b2Body* body, const Grid& grid, int component, b2FixtureDef& def, StaticGeometryStats& stats);
+	static void AddOutline(b2Body* body, const Grid& grid, int component, b2FixtureDef& def, StaticGeometryStats& stats);
+	static void AddBox(b2Body* body, float minX, float minY, float maxX, float maxY, b2FixtureDef& def, StaticGeometryStats& stats);
+
+public:
+	// center y tamao en unidades de render (sin rotacin). Los valores por
+	// defecto de friction y restitution son los de b2FixtureDef
+	void AddRectangle(b2Vec2 center, float sizeX, float sizeY, float friction = 0.2f, float restitution = 0.0f);
+
+	// Crea el body esttico con todos los rectngulos agregados
+	b2Body* Build(b2World* world, StaticMergeMode mode = STATIC_MERGE_CHAIN, CollisionLayer layer = LAYER_STATIC, StaticGeometryStats* stats = nullptr);
+};
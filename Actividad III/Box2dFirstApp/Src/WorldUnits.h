@@ -0,0 +1,65 @@
+//-----------------------------------------------------
+//Conversin entre unidades de render (las que usan SFML
+//y el resto del juego) y metros (las que usa box2d).
+//Box2D 2.4.1 est ajustado para objetos de 0.1 a 10 m:
+//b2_maxTranslation, b2_linearSlop y las tolerancias de
+//sueo estn en metros, por eso todo lo que entra o
+//sale del b2World pasa por estas funciones
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+
+// Unidades de render que entran en un metro
+#define UNITS_PER_METER 10.0f
+
+class WorldUnits
+{
+private:
+	static float& Scale()
+	{
+		static float unitsPerMeter = UNITS_PER_METER;
+		return unitsPerMeter;
+	}
+
+public:
+	//-------------------------------------------------------------
+	// Escala actual. Solo debe cambiarse antes de crear el mundo
+	// (lo usan los benchmarks para comparar contra escala 1)
+	//-------------------------------------------------------------
+	static float GetUnitsPerMeter()
+	{
+		return Scale();
+	}
+
+	static void SetUnitsPerMeter(float unitsPerMeter)
+	{
+		Scale() = unitsPerMeter;
+	}
+
+	//-------------------------------------------------------------
+	// De unidades de render a metros
+	//-------------------------------------------------------------
+	static float ToMeters(float units)
+	{
+		return units / Scale();
+	}
+
+	static b2Vec2 ToMeters(const b2Vec2& units)
+	{
+		return b2Vec2(units.x / Scale(), units.y / Scale());
+	}
+
+	//-------------------------------------------------------------
+	// De metros a unidades de render
+	//-------------------------------------------------------------
+	static float ToUnits(float meters)
+	{
+		return meters * Scale();
+	}
+
+	static b2Vec2 ToUnits(const b2Vec2& meters)
+	{
+		return b2Vec2(meters.x * Scale(), meters.y * Scale());
+	}
+};
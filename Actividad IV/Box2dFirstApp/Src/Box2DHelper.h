@@ -1,9 +1,17 @@
 #include <Box2D/Box2D.h>
+#include "CollisionLayers.h"
+#include "WorldUnits.h"
+#include "PolygonCache.h"
 #pragma once
 
 class Box2DHelper
 {
 public:
+	//-------------------------------------------------------------
+	// Todas las medidas se reciben en unidades de render y se
+	// convierten a metros con WorldUnits antes de llegar a box2d
+	//-------------------------------------------------------------
+
 	//-------------------------------------------------------------
 	// Crea un body dinmico sin fixtures centrado en 0,0
 	//-------------------------------------------------------------
@@ -64,7 +72,7 @@ public:
 
 		b2PolygonShape* box= new b2PolygonShape();
 
-		box->SetAsBox(sizeX/2.0f, sizeY/2.0f,b2Vec2(0.0f,0.0f),0.0f);
+		box->SetAsBox(WorldUnits::ToMeters(sizeX)/2.0f, WorldUnits::ToMeters(sizeY)/2.0f,b2Vec2(0.0f,0.0f),0.0f);
 
 		b2FixtureDef fixtureDef;
 		fixtureDef.shape = box;
@@ -82,7 +90,7 @@ public:
 	{
 		b2CircleShape *circle= new b2CircleShape();
 		circle->m_p=b2Vec2(0.0f,0.0f);
-		circle->m_radius=radius;
+		circle->m_radius=WorldUnits::ToMeters(radius);
 
 		b2FixtureDef fixtureDef;
 		fixtureDef.shape = circle;
@@ -94,12 +102,24 @@ public:
 	}
 
 	//-------------------------------------------------------------
-	// Crea un fixture poligonal dado un conj de puntos
+	// Crea un fixture poligonal dado un conj de puntos (convexo, de
+	// 3 a b2_maxPolygonVertices). Los contornos ms grandes o
+	// cncavos van por PolygonCache (CreatePolyDynamicBody y
+	// CreatePolyStaticBody con cach); ac se rechazan: el fixture
+	// queda sin shape y los Create*Body no lo agregan
 	//-------------------------------------------------------------
 	static b2FixtureDef CreatePolyFixtureDef(b2Vec2* v,int n, float density, float friction, float restitution)
 	{
+		b2Assert(3 <= n && n <= b2_maxPolygonVertices);
+		if (n < 3 || n > b2_maxPolygonVertices)
+			return b2FixtureDef();
+
+		b2Vec2 verts[b2_maxPolygonVertices];
+		for (int i = 0; i < n; i++)
+			verts[i] = WorldUnits::ToMeters(v[i]);
+
 		b2PolygonShape *poly= new b2PolygonShape();
-		poly->Set(v,n);
+		poly->Set(verts,n);
 
 		b2FixtureDef fixtureDef;
 		fixtureDef.shape = poly;
@@ -241,7 +261,8 @@ public:
 	{
 		b2Body* body= CreateDynamicBody(phyWorld);
 		b2FixtureDef tri=CreatePolyFixtureDef(v,n,density,friction,restitution);
-		body->CreateFixture(&tri);
+		if (tri.shape != nullptr)
+			body->CreateFixture(&tri);
 
 		return body;
 	}
@@ -253,7 +274,8 @@ public:
 	{
 		b2Body* body= CreateKinematicBody(phyWorld);
 		b2FixtureDef tri=CreatePolyFixtureDef(v,n,0.0f,0.0f,0.0f);
-		body->CreateFixture(&tri);
+		if (tri.shape != nullptr)
+			body->CreateFixture(&tri);
 
 		return body;
 	}
@@ -265,8 +287,252 @@ public:
 	{
 		b2Body* body= CreateDynamicBody(phyWorld);
 		b2FixtureDef tri=CreatePolyFixtureDef(v,n,0.0f,0.0f,0.0f);
-		body->CreateFixture(&tri);
+		if (tri.shape != nullptr)
+			body->CreateFixture(&tri);
 
 		return body;
 	}
+
+	//-------------------------------------------------------------
+	// Crea un fixture rectangular en la capa de colisin indicada
+	//-------------------------------------------------------------
+	static b2FixtureDef CreateRectangularFixtureDef(float sizeX, float sizeY, float density, float friction, float restitution, CollisionLayer layer)
+	{
+		b2FixtureDef fixtureDef = CreateRectangularFixtureDef(sizeX, sizeY, density, friction, restitution);
+		fixtureDef.filter = CollisionLayers::GetFilter(layer);
+
+		return fixtureDef;
+	}
+
+	//-------------------------------------------------------------
+	// Crea un fixture circular en la capa de colisin indicada
+	//-------------------------------------------------------------
+	static b2FixtureDef CreateCircularFixtureDef(float radius, float density, float friction, float restitution, CollisionLayer layer)
+	{
+		b2FixtureDef fixtureDef = CreateCircularFixtureDef(radius, density, friction, restitution);
+		fixtureDef.filter = CollisionLayers::GetFilter(layer);
+
+		return fixtureDef;
+	}
+
+	//-------------------------------------------------------------
+	// Crea un fixture poligonal en la capa de colisin indicada
+	//-------------------------------------------------------------
+	static b2FixtureDef CreatePolyFixtureDef(b2Vec2* v, int n, float density, float friction, float restitution, CollisionLayer layer)
+	{
+		b2FixtureDef fixtureDef = CreatePolyFixtureDef(v, n, density, friction, restitution);
+		fixtureDef.filter = CollisionLayers::GetFilter(layer);
+
+		return fixtureDef;
+	}
+
+	//-------------------------------------------------------------
+	// Crea un fixture triangular en la capa de colisin indicada
+	//-------------------------------------------------------------
+	static b2FixtureDef CreateTriangularFixtureDef(b2Vec2 c, float h, float density, float friction, float restitution, CollisionLayer layer)
+	{
+		b2FixtureDef fixtureDef = CreateTriangularFixtureDef(c, h, density, friction, restitution);
+		fixtureDef.filter = CollisionLayers::GetFilter(layer);
+
+		return fixtureDef;
+	}
+
+	//-------------------------------------------------------------
+	// Crea un body dinmico rectangular en la capa de colisin indicada
+	//-------------------------------------------------------------
+	static b2Body* CreateRectangularDynamicBody(b2World *phyWorld, float sizeX, float sizeY, float density, float friction, float restitution, CollisionLayer layer)
+	{
+		b2Body* body= CreateDynamicBody(phyWorld);
+		b2FixtureDef box=CreateRectangularFixtureDef(sizeX,sizeY,density,friction,restitution,layer);
+		body->CreateFixture(&box);
+
+		return body;
+	}
+
+	//-------------------------------------------------------------
+	// Crea un body cinemtico rectangular en la capa de colisin indicada
+	//-------------------------------------------------------------
+	static b2Body* CreateRectangularKinematicBody(b2World *phyWorld, float sizeX, float sizeY, CollisionLayer layer)
+	{
+		b2Body* body= CreateKinematicBody(phyWorld);
+		b2FixtureDef box=CreateRectangularFixtureDef(sizeX,sizeY,0.0f,0.0f,0.0f,layer);
+		body->CreateFixture(&box);
+
+		return body;
+	}
+
+	//-------------------------------------------------------------
+	// Crea un body esttico rectangular en la capa de colisin indicada
+	//-------------------------------------------------------------
+	static b2Body* CreateRectangularStaticBody(b2World *phyWorld, float sizeX, float sizeY, CollisionLayer layer)
+	{
+		b2Body* body= CreateStaticBody(phyWorld);
+		b2FixtureDef box=CreateRectangularFixtureDef(sizeX,sizeY,0.0f,0.0f,0.0f,layer);
+		body->CreateFixture(&box);
+
+		return body;
+	}
+
+	//-------------------------------------------------------------
+	// Crea un body dinmico circular en la capa de colisin indicada
+	//-------------------------------------------------------------
+	static b2Body* CreateCircularDynamicBody(b2World *phyWorld, float radius, float density, float friction, float restitution, CollisionLayer layer)
+	{
+		b2Body* body= CreateDynamicBody(phyWorld);
+		b2FixtureDef cir=CreateCircularFixtureDef(radius,density,friction,restitution,layer);
+		body->CreateFixture(&cir);
+
+		return body;
+	}
+
+	//-------------------------------------------------------------
+	// Crea un body cinemtico circular en la capa de colisin indicada
+	//-------------------------------------------------------------
+	static b2Body* CreateCircularKinematicBody(b2World *phyWorld, float radius, CollisionLayer layer)
+	{
+		b2Body* body= CreateKinematicBody(phyWorld);
+		b2FixtureDef cir=CreateCircularFixtureDef(radius,0.0f,0.0f,0.0f,layer);
+		body->CreateFixture(&cir);
+
+		return body;
+	}
+
+	//-------------------------------------------------------------
+	// Crea un body esttico circular en la capa de colisin indicada
+	//-------------------------------------------------------------
+	static b2Body* CreateCircularStaticBody(b2World *phyWorld, float radius, CollisionLayer layer)
+	{
+		b2Body* body= CreateStaticBody(phyWorld);
+		b2FixtureDef cir=CreateCircularFixtureDef(radius,0.0f,0.0f,0.0f,layer);
+		body->CreateFixture(&cir);
+
+		return body;
+	}
+
+	//-------------------------------------------------------------
+	// Crea un body sin fixtures ya ubicado en position con el ngulo
+	// dado. Un SetTransform despus de crear el body mueve otra vez
+	// cada proxy del broadphase; armado en su lugar se inserta una vez
+	//-------------------------------------------------------------
+	static b2Body* CreateBody(b2World *phyWorld, b2BodyType type, b2Vec2 position, float angle)
+	{
+		b2BodyDef bodyDef;
+		bodyDef.type = type;
+		bodyDef.position = WorldUnits::ToMeters(position);
+		bodyDef.angle = angle;
+
+		return phyWorld->CreateBody(&bodyDef);
+	}
+
+	//-------------------------------------------------------------
+	// Crea un body dinmico rectangular en la capa indicada, ya ubicado en position
+	//-------------------------------------------------------------
+	static b2Body* CreateRectangularDynamicBody(b2World *phyWorld, float sizeX, float sizeY, float density, float friction, float restitution, CollisionLayer layer, b2Vec2 position, float angle = 0.0f)
+	{
+		b2Body* body= CreateBody(phyWorld, b2_dynamicBody, position, angle);
+		b2FixtureDef box=CreateRectangularFixtureDef(sizeX,sizeY,density,friction,restitution,layer);
+		body->CreateFixture(&box);
+
+		return body;
+	}
+
+	//-------------------------------------------------------------
+	// Crea un body cinemtico rectangular en la capa indicada, ya ubicado en position
+	//-------------------------------------------------------------
+	static b2Body* CreateRectangularKinematicBody(b2World *phyWorld, float sizeX, float sizeY, CollisionLayer layer, b2Vec2 position, float angle = 0.0f)
+	{
+		b2Body* body= CreateBody(phyWorld, b2_kinematicBody, position, angle);
+		b2FixtureDef box=CreateRectangularFixtureDef(sizeX,sizeY,0.0f,0.0f,0.0f,layer);
+		body->CreateFixture(&box);
+
+		return body;
+	}
+
+	//-------------------------------------------------------------
+	// Crea un body esttico rectangular en la capa indicada, ya ubicado en position
+	//-------------------------------------------------------------
+	static b2Body* CreateRectangularStaticBody(b2World *phyWorld, float sizeX, float sizeY, CollisionLayer layer, b2Vec2 position, float angle = 0.0f)
+	{
+		b2Body* body= CreateBody(phyWorld, b2_staticBody, position, angle);
+		b2FixtureDef box=CreateRectangularFixtureDef(sizeX,sizeY,0.0f,0.0f,0.0f,layer);
+		body->CreateFixture(&box);
+
+		return body;
+	}
+
+	//-------------------------------------------------------------
+	// Crea un body dinmico circular en la capa indicada, ya ubicado en position
+	//-------------------------------------------------------------
+	static b2Body* CreateCircularDynamicBody(b2World *phyWorld, float radius, float density, float friction, float restitution, CollisionLayer layer, b2Vec2 position)
+	{
+		b2Body* body= CreateBody(phyWorld, b2_dynamicBody, position, 0.0f);
+		b2FixtureDef cir=CreateCircularFixtureDef(radius,density,friction,restitution,layer);
+		body->CreateFixture(&cir);
+
+		return body;
+	}
+
+	//-------------------------------------------------------------
+	// Crea un body cinemtico circular en la capa indicada, ya ubicado en position
+	//-------------------------------------------------------------
+	static b2Body* CreateCircularKinematicBody(b2World *phyWorld, float radius, CollisionLayer layer, b2Vec2 position)
+	{
+		b2Body* body= CreateBody(phyWorld, b2_kinematicBody, position, 0.0f);
+		b2FixtureDef cir=CreateCircularFixtureDef(radius,0.0f,0.0f,0.0f,layer);
+		body->CreateFixture(&cir);
+
+		return body;
+	}
+
+	//-------------------------------------------------------------
+	// Crea un body esttico circular en la capa indicada, ya ubicado en position
+	//-------------------------------------------------------------
+	static b2Body* CreateCircularStaticBody(b2World *phyWorld, float radius, CollisionLayer layer, b2Vec2 position)
+	{
+		b2Body* body= CreateBody(phyWorld, b2_staticBody, position, 0.0f);
+		b2FixtureDef cir=CreateCircularFixtureDef(radius,0.0f,0.0f,0.0f,layer);
+		body->CreateFixture(&cir);
+
+		return body;
+	}
+
+	//-------------------------------------------------------------
+	// Crea un body dinmico con un contorno de n vrtices (cncavo y
+	// de ms de b2_maxPolygonVertices), ya ubicado en position. La
+	// cach lo parte en piezas convexas la primera vez y agrega todas
+	// las piezas como fixtures de una vez
+	//-------------------------------------------------------------
+	static b2Body* CreatePolyDynamicBody(b2World *phyWorld, PolygonCache& cache, b2Vec2 *v, int n, float density, float friction, float restitution, CollisionLayer layer, b2Vec2 position, float angle = 0.0f)
+	{
+		b2Body* body= CreateBody(phyWorld, b2_dynamicBody, position, angle);
+		PolygonCache::Attach(body, cache.Get(v, n), density, friction, restitution, CollisionLayers::GetFilter(layer));
+
+		return body;
+	}
+
+	//-------------------------------------------------------------
+	// Crea un body esttico con un contorno de n vrtices, ya ubicado en position
+	//-------------------------------------------------------------
+	static b2Body* CreatePolyStaticBody(b2World *phyWorld, PolygonCache& cache, b2Vec2 *v, int n, CollisionLayer layer, b2Vec2 position, float angle = 0.0f)
+	{
+		b2Body* body= CreateBody(phyWorld, b2_staticBody, position, angle);
+		PolygonCache::Attach(body, cache.Get(v, n), 0.0f, 0.0f, 0.0f, CollisionLayers::GetFilter(layer));
+
+		return body;
+	}
+
+	//-------------------------------------------------------------
+	// Indica si no queda ningn body despierto en el mundo
+	// (los estticos nunca estn despiertos)
+	//-------------------------------------------------------------
+	static bool IsWorldAsleep(b2World *phyWorld)
+	{
+		for (b2Body* body = phyWorld->GetBodyList(); body; body = body->GetNext())
+		{
+			if (body->IsAwake())
+				return false;
+		}
+
+		return true;
+	}
 };
\ No newline at end of file
@@ -0,0 +1,23 @@
+#include "Game.h" // Incluye el archivo de encabezado de la clase Game
+#include "VecEnv.h" // Entorno vectorizado sin ventana
+#include <tchar.h> // Incluye la biblioteca de caracteres de Windows
+
+using namespace sf; // Espacio de nombres para la biblioteca SFML
+
+// Funcin principal del programa
+int _tmain(int argc, _TCHAR* argv[])
+{
+    // Con --vecenv se mide el rendimiento del entorno vectorizado sin abrir la ventana
+    if (argc > 1 && _tcscmp(argv[1], _T("--vecenv")) == 0)
+    {
+        VecEnv::RunThroughput(argc > 2 ? _ttoi(argv[2]) : 256, 600);
+        return 0;
+    }
+
+    // Crear el objeto de la clase Game
+    Game* Juego;
+    Juego = new Game(800, 600, "MAVII");
+    Juego->Loop(); // Ejecutar el bucle principal del juego
+
+    return 0; // Retorna 0 indicando que el programa se ha ejecutado correctamente
+}
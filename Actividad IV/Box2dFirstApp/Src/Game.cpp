@@ -7,10 +7,12 @@ Game::Game(int ancho, int alto, std::string titulo)
 {
     // Inicializacin de la ventana y configuracin de propiedades
     wnd = new RenderWindow(VideoMode(ancho, alto), titulo);
+    title = titulo;
     wnd->setVisible(true);
     fps = 60;
     wnd->setFramerateLimit(fps);
     frameTime = 1.0f / fps;
+    needsRedraw = true;
     SetZoom(); // Configuracin de la vista del juego
     InitPhysics(); // Inicializacin del motor de fsica
 }
@@ -20,21 +22,58 @@ void Game::Loop()
 {
     while (wnd->isOpen())
     {
+        // Mundo dormido y sin teclas apretadas: no se simula ni se dibuja
+        if (IsIdle())
+        {
+            if (!needsRedraw)
+            {
+                WaitForEvent(); // Bloquea hasta el prximo evento de la ventana
+                continue;
+            }
+
+            // Solo se vuelve a presentar el ltimo estado (p. ej. despus de un resize)
+            wnd->clear(clearColor);
+            debugRender->DrawWorld(phyWorld);
+            DrawGame();
+            wnd->display();
+            needsRedraw = false;
+            continue;
+        }
+
         wnd->clear(clearColor); // Limpiar la ventana
         DoEvents(); // Procesar eventos de entrada
         CheckCollitions(); // Comprobar colisiones
         UpdatePhysics(); // Actualizar la simulacin fsica
         DrawGame(); // Dibujar el juego
+        UpdateTitle(); // Mostrar los golpes en el ttulo
         wnd->display(); // Mostrar la ventana
+        needsRedraw = false;
     }
 }
 
+// El juego est ocioso si ningn body est despierto y no hay flechas apretadas
+bool Game::IsIdle()
+{
+    if (Keyboard::isKeyPressed(Keyboard::Left) || Keyboard::isKeyPressed(Keyboard::Right))
+        return false;
+
+    return Box2DHelper::IsWorldAsleep(phyWorld);
+}
+
+// Espera bloqueante de un evento (uso de CPU casi nulo mientras tanto)
+void Game::WaitForEvent()
+{
+    Event evt;
+    if (wnd->waitEvent(evt))
+        ProcessEvent(evt);
+}
+
 // Actualizacin de la simulacin fsica
 void Game::UpdatePhysics()
 {
-    phyWorld->Step(frameTime, 8, 8); // Simular el mundo fsico
+    phyWorld->Step(frameTime, 8, 3); // Simular el mundo fsico
     phyWorld->ClearForces(); // Limpiar las fuerzas aplicadas a los cuerpos
-    phyWorld->DebugDraw(); // Dibujar el mundo fsico para depuracin
+    debugRender->DrawWorld(phyWorld); // Dibujar lo visible del mundo fsico para depuracin
 }
 
 // Dibujo de los elementos del juego
@@ -59,7 +98,8 @@ void Game::DrawGame()
 
     sf::RectangleShape controlShape(sf::Vector2f(10, 10));
     controlShape.setFillColor(sf::Color::Magenta);
-    controlShape.setPosition(controlBody->GetPosition().x - 5, controlBody->GetPosition().y - 5);
+    b2Vec2 controlPos = WorldUnits::ToUnits(controlBody->GetPosition());
+    controlShape.setPosition(controlPos.x - 5, controlPos.y - 5);
     wnd->draw(controlShape);
 }
 
@@ -68,29 +108,64 @@ void Game::DoEvents()
 {
     Event evt;
     while (wnd->pollEvent(evt))
-    {
-        switch (evt.type)
-        {
-        case Event::Closed:
-            wnd->close(); // Cerrar la ventana si se presiona el botn de cerrar
-            break;
-        }
-    }
+        ProcessEvent(evt);
 
     // Controlar el movimiento del cuerpo de control con el teclado
     // Segun la numeracion usada, cuando mas cerca de cero mas 
     // lento es el desplazamiento sobre ese eje
-    controlBody->SetAwake(true);
+    int action = ACTION_NONE;
     if (Keyboard::isKeyPressed(Keyboard::Left))
-        controlBody->SetLinearVelocity(b2Vec2(-30.0f, 0.0f));
+        action = ACTION_LEFT;
     if (Keyboard::isKeyPressed(Keyboard::Right))
-        controlBody->SetLinearVelocity(b2Vec2(30.0f, 0.0f));
+        action = ACTION_RIGHT;
+    ApplyAction(controlBody, action);
 }
 
-// Comprobacin de colisiones (a implementar ms adelante)
+// Aplica una accin al cuerpo de control (teclado o entorno vectorizado).
+// Sin accin no se despierta al cuerpo, as el mundo puede dormirse
+void Game::ApplyAction(b2Body* control, int action)
+{
+    if (action != ACTION_NONE)
+        control->SetAwake(true);
+    if (action == ACTION_LEFT)
+        control->SetLinearVelocity(WorldUnits::ToMeters(b2Vec2(-30.0f, 0.0f)));
+    else if (action == ACTION_RIGHT)
+        control->SetLinearVelocity(WorldUnits::ToMeters(b2Vec2(30.0f, 0.0f)));
+}
+
+// Eventos de la ventana (desde pollEvent o waitEvent)
+void Game::ProcessEvent(const Event& evt)
+{
+    switch (evt.type)
+    {
+    case Event::Closed:
+        wnd->close(); // Cerrar la ventana si se presiona el botn de cerrar
+        break;
+    case Event::Resized:
+    case Event::GainedFocus:
+        needsRedraw = true; // El contenido de la ventana se perdi
+        break;
+    }
+}
+
+// Comprobacin de colisiones: procesa en bloque los eventos del ltimo Step
 void Game::CheckCollitions()
 {
-    // Implementacin de la comprobacin de colisiones
+    // Vaciar la cola de contactos contando los golpes nuevos
+    contactQueue->Drain(0xFFFF, [this](const ContactEvent& evt)
+    {
+        if (evt.type == CONTACT_HIT)
+            impactCount++;
+    });
+}
+
+// Muestra los golpes en el ttulo; solo se cambia cuando hay golpes nuevos
+void Game::UpdateTitle()
+{
+    if (impactCount == shownImpactCount)
+        return;
+    shownImpactCount = impactCount;
+    wnd->setTitle(title + " - golpes: " + std::to_string(impactCount));
 }
 
 // Configuracin de la vista del juego
@@ -106,31 +181,51 @@ void Game::SetZoom()
 // Inicializacin del motor de fsica y los cuerpos del mundo fsico
 void Game::InitPhysics()
 {
-    // Inicializar el mundo fsico con la gravedad por defecto
-    phyWorld = new b2World(b2Vec2(0.0f, 9.8f));
+    // Inicializar el mundo fsico (la gravedad la define BuildScene)
+    phyWorld = new b2World(b2Vec2(0.0f, 0.0f));
 
     // Crear un renderer de debug para visualizar el mundo fsico
     debugRender = new SFMLRenderer(wnd);
     debugRender->SetFlags(UINT_MAX);
     phyWorld->SetDebugDraw(debugRender);
 
+    // Instalar la cola de eventos de contacto (se vaca en CheckCollitions)
+    contactQueue = new ContactQueue(4096);
+    phyWorld->SetContactListener(contactQueue);
+    phyWorld->SetDestructionListener(contactQueue);
+    impactCount = 0;
+    shownImpactCount = 0;
+
+    // Crear la escena (la misma que usa el entorno vectorizado)
+    controlBody = BuildScene(phyWorld);
+}
+
+// Creacin de la gravedad, el suelo, las paredes y el cuadrado de control en el mundo dado.
+// Devuelve el cuadrado de control
+b2Body* Game::BuildScene(b2World* world)
+{
+    // Gravedad por defecto
+    world->SetGravity(WorldUnits::ToMeters(b2Vec2(0.0f, 9.8f)));
+
     // Crear el suelo y las paredes estticas del mundo fsico
-    b2Body* groundBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 500, 10);
-    groundBody->SetTransform(b2Vec2(0.0f, 55.0f), 0.0f);
+    b2Body* groundBody = Box2DHelper::CreateRectangularStaticBody(world, 500, 10);
+    groundBody->SetTransform(WorldUnits::ToMeters(b2Vec2(0.0f, 55.0f)), 0.0f);
     b2Fixture* fixture = groundBody->GetFixtureList();
     if (fixture) {
         fixture->SetFriction(0.5f); //el coeficiente de rozamiento de madera sobre madera est entre 0,25 y 0,50
     }
   
-    b2Body* rightWallBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 10, 100);
-    rightWallBody->SetTransform(b2Vec2(100.0f, 50.0f), 0.0f);
+    b2Body* rightWallBody = Box2DHelper::CreateRectangularStaticBody(world, 10, 100);
+    rightWallBody->SetTransform(WorldUnits::ToMeters(b2Vec2(100.0f, 50.0f)), 0.0f);
 
-    b2Body* leftWallBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 10, 100);
-    leftWallBody->SetTransform(b2Vec2(0.0f, 50.0f), 0.0f);
+    b2Body* leftWallBody = Box2DHelper::CreateRectangularStaticBody(world, 10, 100);
+    leftWallBody->SetTransform(WorldUnits::ToMeters(b2Vec2(0.0f, 50.0f)), 0.0f);
 
     // Crear un cuadrado que se controlar con el teclado
-    controlBody = Box2DHelper::CreateRectangularDynamicBody(phyWorld, 10, 10, 1.0f, 0.5f, 0.5f);
-    controlBody->SetTransform(b2Vec2(50.0f, 50.0f), 0.0f);
+    b2Body* control = Box2DHelper::CreateRectangularDynamicBody(world, 10, 10, 1.0f, 0.5f, 0.5f);
+    control->SetTransform(WorldUnits::ToMeters(b2Vec2(50.0f, 50.0f)), 0.0f);
+
+    return control;
 }
 
 // Destructor de la clase
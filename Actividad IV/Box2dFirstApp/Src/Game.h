@@ -2,6 +2,8 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
 #include "SFMLRenderer.h"
+#include "ContactQueue.h"
+#include "VecEnv.h"
 #include <list>
 
 using namespace sf;
@@ -17,11 +19,20 @@ private:
 	// Objetos de box2d
 	b2World *phyWorld;
 	SFMLRenderer *debugRender;
+	ContactQueue *contactQueue;
+
+	// Golpes registrados por la cola de contactos, se muestran en el ttulo
+	int impactCount;
+	int shownImpactCount;
+	std::string title;
 
 	//tiempo de frame
 	float frameTime;
 	int fps;
 
+	// Hay que volver a presentar el frame aunque el juego est ocioso
+	bool needsRedraw;
+
 	// Cuerpo de box2d
 	b2Body* controlBody;
 
@@ -34,11 +45,19 @@ public:
 	~Game(void);
 	void InitPhysics();
 
+	// Escena y control compartidos con el entorno vectorizado (no dependen de la ventana)
+	static b2Body* BuildScene(b2World* world);
+	static void ApplyAction(b2Body* control, int action);
+
 	// Main game loop
 	void Loop();
 	void DrawGame();
 	void UpdatePhysics();
 	void DoEvents();
+	void ProcessEvent(const Event& evt);
+	bool IsIdle();
+	void WaitForEvent();
 	void SetZoom();
+	void UpdateTitle();
 };
 
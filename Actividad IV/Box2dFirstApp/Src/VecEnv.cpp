@@ -0,0 +1,133 @@
+#include "VecEnv.h"
+#include "Game.h"
+#include <iostream>
+
+// Constructor: crea los mundos y escribe la primera observacin
+VecEnv::VecEnv(int count, float* buffer, int threadCount)
+{
+    envs.resize(count);
+    for (Env& env : envs)
+    {
+        env.world = nullptr;
+        env.control = nullptr;
+    }
+
+    if (buffer != nullptr)
+        observations = buffer;
+    else
+    {
+        ownedObservations.resize(count * OBS_SIZE);
+        observations = ownedObservations.data();
+    }
+
+    jobs = threadCount == 1 ? nullptr : new JobSystem(threadCount);
+    timeStep = 1.0f / 60.0f;
+    Reset();
+}
+
+// Destructor: libera los mundos (el buffer externo no es nuestro)
+VecEnv::~VecEnv(void)
+{
+    for (Env& env : envs)
+        delete env.world;
+    delete jobs;
+}
+
+// Crea el mundo index desde cero con la escena del juego
+void VecEnv::Build(int index)
+{
+    Env& env = envs[index];
+    delete env.world;
+    env.world = new b2World(b2Vec2(0.0f, 0.0f));
+    env.control = Game::BuildScene(env.world);
+}
+
+// Escribe el estado del cuerpo de control en su lugar del buffer
+void VecEnv::Observe(int index)
+{
+    const b2Body* control = envs[index].control;
+    float* obs = observations + index * OBS_SIZE;
+
+    int touching = 0;
+    for (const b2ContactEdge* edge = control->GetContactList(); edge; edge = edge->next)
+    {
+        if (edge->contact->IsTouching())
+            touching++;
+    }
+
+    obs[OBS_X] = control->GetPosition().x;
+    obs[OBS_Y] = control->GetPosition().y;
+    obs[OBS_VX] = control->GetLinearVelocity().x;
+    obs[OBS_VY] = control->GetLinearVelocity().y;
+    obs[OBS_ANGLE] = control->GetAngle();
+    obs[OBS_CONTACTS] = (float)touching;
+}
+
+void VecEnv::Reset()
+{
+    for (int i = 0; i < GetCount(); i++)
+        Reset(i);
+}
+
+void VecEnv::Reset(int index)
+{
+    Build(index);
+    Observe(index);
+}
+
+// Los mundos de [begin, end) no comparten nada, se pueden simular en cualquier hilo
+void VecEnv::StepRange(const int* actions, int begin, int end)
+{
+    for (int i = begin; i < end; i++)
+    {
+        Game::ApplyAction(envs[i].control, actions[i]);
+        envs[i].world->Step(timeStep, 8, 3);
+        envs[i].world->ClearForces();
+        Observe(i);
+    }
+}
+
+void VecEnv::Step(const int* actions)
+{
+    if (jobs == nullptr)
+    {
+        StepRange(actions, 0, GetCount());
+        return;
+    }
+
+    // Bloques de 16 mundos: suficiente trabajo por tarea y margen para repartir
+    jobs->ParallelFor(GetCount(), 16, [this, actions](int begin, int end)
+    {
+        StepRange(actions, begin, end);
+    });
+}
+
+// Corre el mismo nmero de pasos en un hilo y en todos los ncleos
+void VecEnv::RunThroughput(int count, int steps)
+{
+    std::vector<int> actions(count);
+
+    const int threadCounts[] = { 1, 0 };
+    for (int threads : threadCounts)
+    {
+        VecEnv env(count, nullptr, threads);
+        unsigned int seed = 12345;
+        b2Timer timer;
+
+        for (int step = 0; step < steps; step++)
+        {
+            // Acciones al azar con un generador congruencial (igual en las dos corridas)
+            for (int i = 0; i < count; i++)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                actions[i] = (int)((seed >> 16) % ACTION_COUNT);
+            }
+            env.Step(actions.data());
+        }
+
+        float seconds = timer.GetMilliseconds() / 1000.0f;
+        std::cout << count << " mundos x " << steps << " pasos, "
+            << (threads == 1 ? "1 hilo" : "todos los hilos") << ": "
+            << (int)(count * steps / seconds) << " pasos de entorno/s" << std::endl;
+    }
+}
@@ -0,0 +1,80 @@
+//-----------------------------------------------------
+//Entorno vectorizado para entrenar controladores del
+//cuerpo de control sin ventana. Mantiene N mundos con
+//la escena de la actividad (Game::BuildScene), aplica
+//una accin por mundo en cada paso y escribe el estado
+//de cada cuerpo de control en un nico buffer de floats
+//contiguo. El buffer puede ser de quien lo usa (por
+//ejemplo memoria compartida con un entrenador externo):
+//los mundos escriben directamente ah, sin copias
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <vector>
+#include "JobSystem.h"
+
+// Acciones posibles para el cuerpo de control (las mismas que las flechas)
+enum ControlAction
+{
+	ACTION_NONE = 0,
+	ACTION_LEFT,
+	ACTION_RIGHT,
+	ACTION_COUNT
+};
+
+// ndices de cada dato dentro de la observacin de un mundo (en metros, de box2d)
+enum ObservationField
+{
+	OBS_X = 0,
+	OBS_Y,
+	OBS_VX,
+	OBS_VY,
+	OBS_ANGLE,
+	OBS_CONTACTS,		// contactos que el cuerpo est tocando
+	OBS_SIZE
+};
+
+class VecEnv
+{
+private:
+	// Un mundo del entorno
+	struct Env
+	{
+		b2World* world;
+		b2Body* control;
+	};
+
+	std::vector<Env> envs;
+
+	// Observaciones: OBS_SIZE floats por mundo, uno detrs de otro
+	float* observations;
+	std::vector<float> ownedObservations;
+
+	JobSystem* jobs;
+	float timeStep;
+
+	void Build(int index);
+	void Observe(int index);
+	void StepRange(const int* actions, int begin, int end);
+
+public:
+	// buffer (opcional) debe tener lugar para count * OBS_SIZE floats y vivir ms que el entorno.
+	// threadCount como en JobSystem; 1 corre todo en el hilo que llama
+	VecEnv(int count, float* buffer = nullptr, int threadCount = 0);
+	~VecEnv(void);
+
+	// Vuelve a crear todos los mundos, o uno solo (fin de episodio)
+	void Reset();
+	void Reset(int index);
+
+	// Aplica actions[i] al mundo i y avanza todos un paso de 1/60 s
+	void Step(const int* actions);
+
+	const float* GetObservations() const { return observations; }
+	const float* GetObservation(int index) const { return observations + index * OBS_SIZE; }
+	int GetCount() const { return (int)envs.size(); }
+
+	// Mide pasos de entorno por segundo con acciones al azar, en un hilo y en todos
+	static void RunThroughput(int count, int steps);
+};
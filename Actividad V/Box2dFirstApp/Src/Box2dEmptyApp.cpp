@@ -0,0 +1,31 @@
+#include "Game.h" // Incluye el archivo de encabezado de la clase Game
+#include "Sweep.h" // Barrido de parmetros sin ventana
+#include "LodScheduler.h" // Comparacin de pasos con y sin frecuencias por regin
+#include <tchar.h> // Incluye la biblioteca de caracteres de Windows
+
+using namespace sf; // Espacio de nombres para la biblioteca SFML
+
+// Funcin principal del programa
+int _tmain(int argc, _TCHAR* argv[])
+{
+    // Con --sweep se corre el barrido de parmetros sin abrir la ventana
+    if (argc > 1 && _tcscmp(argv[1], _T("--sweep")) == 0)
+    {
+        Sweep::Run(600);
+        return 0;
+    }
+
+    // Con --lod se compara el paso completo contra el scheduler de frecuencias
+    if (argc > 1 && _tcscmp(argv[1], _T("--lod")) == 0)
+    {
+        LodScheduler::RunBenchmark(argc > 2 ? _ttoi(argv[2]) : 2000, 600);
+        return 0;
+    }
+
+    // Crear el objeto de la clase Game
+    Game* Juego;
+    Juego = new Game(800, 600, "MAVII");
+    Juego->Loop(); // Ejecutar el bucle principal del juego
+
+    return 0; // Retorna 0 indicando que el programa se ha ejecutado correctamente
+}
@@ -0,0 +1,104 @@
+#include "Camera.h"
+#include "WorldUnits.h"
+#include <cmath>
+
+// Constructor: vista del tamao dado, centrada en el origen
+Camera::Camera(sf::RenderWindow* wnd, float width, float height)
+{
+    this->wnd = wnd;
+    view.setSize(width, height);
+    target = nullptr;
+    center.SetZero();
+    followSpeed = 5.0f;
+    shiftThreshold = 200.0f;
+    originX = 0.0;
+    originY = 0.0;
+    shiftCount = 0;
+    SetCenter(0.0f, 0.0f);
+}
+
+// Body que sigue la cmara
+void Camera::SetTarget(b2Body* body)
+{
+    target = body;
+}
+
+// Mueve la vista sin suavizado
+void Camera::SetCenter(float x, float y)
+{
+    center.Set(x, y);
+    view.setCenter(center.x, center.y);
+    wnd->setView(view);
+}
+
+// Velocidad de seguimiento (0 deja la cmara quieta)
+void Camera::SetFollowSpeed(float speed)
+{
+    followSpeed = speed;
+}
+
+// Distancia al origen que dispara el corrimiento
+void Camera::SetShiftThreshold(float units)
+{
+    shiftThreshold = units;
+}
+
+// Seguimiento del objetivo y corrimiento del origen
+void Camera::Update(b2World* world, float dt)
+{
+    if (target != nullptr)
+    {
+        // Acercamiento exponencial al objetivo, independiente del frame rate
+        b2Vec2 targetPos = WorldUnits::ToUnits(target->GetPosition());
+        float t = 1.0f - expf(-followSpeed * dt);
+        center += t * (targetPos - center);
+    }
+
+    if (fabsf(center.x) > shiftThreshold || fabsf(center.y) > shiftThreshold)
+        ShiftOrigin(world);
+
+    view.setCenter(center.x, center.y);
+    wnd->setView(view);
+}
+
+// Corre el origen del mundo hasta la posicin de la cmara
+void Camera::ShiftOrigin(b2World* world)
+{
+    // Se redondea a mltiplos del umbral para que el corrimiento sea exacto en float
+    b2Vec2 shift;
+    shift.x = floorf(center.x / shiftThreshold + 0.5f) * shiftThreshold;
+    shift.y = floorf(center.y / shiftThreshold + 0.5f) * shiftThreshold;
+
+    // box2d resta newOrigin a todas las posiciones; la vista se corre lo mismo
+    world->ShiftOrigin(WorldUnits::ToMeters(shift));
+    center -= shift;
+    originX += shift.x;
+    originY += shift.y;
+    shiftCount++;
+}
+
+b2AABB Camera::GetViewBounds() const
+{
+    b2Vec2 half(view.getSize().x / 2.0f, view.getSize().y / 2.0f);
+    b2AABB bounds;
+    bounds.lowerBound = center - half;
+    bounds.upperBound = center + half;
+    return bounds;
+}
+
+// De coordenadas globales del nivel a locales
+b2Vec2 Camera::ToLocal(double x, double y) const
+{
+    return b2Vec2((float)(x - originX), (float)(y - originY));
+}
+
+// De coordenadas locales a globales del nivel
+double Camera::GetGlobalX(const b2Vec2& local) const
+{
+    return originX + local.x;
+}
+
+double Camera::GetGlobalY(const b2Vec2& local) const
+{
+    return originY + local.y;
+}
@@ -0,0 +1,64 @@
+//-----------------------------------------------------
+//Cmara que sigue a un body y mueve la vista de SFML.
+//Cuando el objetivo se aleja del origen ms que el
+//umbral, corre el origen del mundo con b2World::ShiftOrigin
+//para que box2d siempre trabaje con coordenadas chicas
+//(la precisin del float cae lejos del origen). Como el
+//render dibuja con las posiciones de box2d, la vista se
+//corre la misma distancia y no se ve ningn salto; el
+//desplazamiento acumulado queda guardado en double para
+//poder pasar a coordenadas globales del nivel
+//-----------------------------------------------------
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <Box2D/Box2D.h>
+
+class Camera
+{
+private:
+	sf::RenderWindow* wnd;
+	sf::View view;
+
+	// Body seguido por la cmara (puede ser nullptr)
+	b2Body* target;
+
+	// Centro de la vista en coordenadas locales (unidades de render)
+	b2Vec2 center;
+
+	// Qu tan rpido alcanza la cmara al objetivo (1/s)
+	float followSpeed;
+
+	// Distancia al origen, en unidades de render, a partir de la cual se corre el origen
+	float shiftThreshold;
+
+	// Origen local medido en coordenadas globales del nivel (unidades de render)
+	double originX;
+	double originY;
+	int shiftCount;
+
+	void ShiftOrigin(b2World* world);
+
+public:
+	Camera(sf::RenderWindow* wnd, float width, float height);
+
+	// Objetivo y parmetros del seguimiento
+	void SetTarget(b2Body* body);
+	void SetCenter(float x, float y);
+	void SetFollowSpeed(float speed);
+	void SetShiftThreshold(float units);
+
+	// Sigue al objetivo, corre el origen si hace falta y aplica la vista.
+	// Debe llamarse fuera de Step (ShiftOrigin no se puede usar con el mundo bloqueado)
+	void Update(b2World* world, float dt);
+
+	// Conversin entre coordenadas locales (las de box2d y el render) y globales del nivel
+	b2Vec2 ToLocal(double x, double y) const;
+	double GetGlobalX(const b2Vec2& local) const;
+	double GetGlobalY(const b2Vec2& local) const;
+
+	// Rectngulo visible en coordenadas locales (unidades de render)
+	b2AABB GetViewBounds() const;
+
+	int GetShiftCount() const { return shiftCount; }
+};
@@ -0,0 +1,217 @@
+#include "ChunkStreamer.h"
+#include "Box2DHelper.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+
+// Constructor: los trozos se piden en el primer Update
+ChunkStreamer::ChunkStreamer(JobSystem* jobs, const ChunkSettings& settings)
+{
+    this->jobs = jobs;
+    this->settings = settings;
+    along.Set(cosf(settings.angle), sinf(settings.angle));
+    up.Set(along.y, -along.x);
+    inFlight = 0;
+    lastUpdateMs = 0.0f;
+    bodiesCreated = 0;
+    bodiesDestroyed = 0;
+}
+
+// Los trabajos pendientes escriben en ready: hay que esperarlos
+ChunkStreamer::~ChunkStreamer(void)
+{
+    jobs->Wait();
+}
+
+// Contina el suelo de la escena: 30, desde su extremo inferior
+ChunkSettings ChunkStreamer::DefaultSettings()
+{
+    ChunkSettings settings;
+    settings.angle = 0.523599f;
+    settings.startX = 250.0 * cos(settings.angle) + 5.0 * sin(settings.angle);
+    settings.startY = 5.0 + 250.0 * sin(settings.angle) - 5.0 * cos(settings.angle);
+    settings.length = 100.0f;
+    settings.segments = 8;
+    settings.thickness = 10.0f;
+    settings.bumpHeight = 3.0f;
+    settings.bumpLength = 150.0f;
+    settings.friction = 0.0f;
+    settings.restitution = 0.5f;
+    settings.loadAhead = 3;
+    settings.loadBehind = 1;
+    settings.unloadDistance = 5;
+    settings.budgetMs = 1.0f;
+    return settings;
+}
+
+// Punto de la superficie a distancia s del comienzo, medida a lo largo de la rampa.
+// La ondulacin vale 0 en s = 0 para empalmar con el suelo de la escena
+void ChunkStreamer::Surface(double s, double& x, double& y) const
+{
+    double h = settings.bumpHeight * sin(2.0 * b2_pi * s / settings.bumpLength);
+    x = settings.startX + s * along.x + h * up.x;
+    y = settings.startY + s * along.y + h * up.y;
+}
+
+// Corre en un hilo del pool: solo lee settings y escribe en data
+void ChunkStreamer::Prepare(int index, ChunkData& data) const
+{
+    data.index = index;
+    double s0 = (double)index * settings.length;
+    Surface(s0, data.originX, data.originY);
+
+    // Superficie relativa al origen del trozo
+    std::vector<b2Vec2> top(settings.segments + 1);
+    for (int k = 0; k <= settings.segments; k++)
+    {
+        double x, y;
+        Surface(s0 + (double)k * settings.length / settings.segments, x, y);
+        top[k].Set((float)(x - data.originX), (float)(y - data.originY));
+    }
+
+    sf::Color color = (index % 2 == 0) ? sf::Color(200, 60, 60) : sf::Color(160, 40, 40);
+    b2Vec2 depth = settings.thickness * up;
+    for (int k = 0; k < settings.segments; k++)
+    {
+        b2Vec2 quad[4] = { top[k], top[k + 1], top[k + 1] - depth, top[k] - depth };
+
+        b2Vec2 verts[4];
+        for (int i = 0; i < 4; i++)
+            verts[i] = WorldUnits::ToMeters(quad[i]);
+        b2PolygonShape piece;
+        piece.Set(verts, 4);
+        data.pieces.push_back(piece);
+
+        const int order[6] = { 0, 1, 2, 0, 2, 3 };
+        for (int i : order)
+            data.vertices.push_back(sf::Vertex(sf::Vector2f(quad[i].x, quad[i].y), color));
+    }
+}
+
+bool ChunkStreamer::IsRequested(int index) const
+{
+    return std::find(requested.begin(), requested.end(), index) != requested.end();
+}
+
+void ChunkStreamer::Request(int index)
+{
+    requested.push_back(index);
+    inFlight++;
+    jobs->Submit([this, index]
+    {
+        std::unique_ptr<ChunkData> data(new ChunkData());
+        Prepare(index, *data);
+        {
+            std::lock_guard<std::mutex> lock(readyMutex);
+            ready.push_back(std::move(data));
+        }
+        inFlight--;
+    });
+}
+
+// Trozo en el que cae la proyeccin del punto sobre la rampa
+int ChunkStreamer::FocusIndex(double x, double y) const
+{
+    double s = (x - settings.startX) * along.x + (y - settings.startY) * along.y;
+    return (int)floor(s / settings.length);
+}
+
+void ChunkStreamer::Update(b2World* world, const Camera& camera, double focusX, double focusY)
+{
+    typedef std::chrono::steady_clock Clock;
+    Clock::time_point start = Clock::now();
+    auto elapsedMs = [start]()
+    {
+        return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+    };
+
+    int focus = FocusIndex(focusX, focusY);
+    for (int i = focus - settings.loadBehind; i <= focus + settings.loadAhead; i++)
+    {
+        if (i >= 0 && loaded.find(i) == loaded.end() && !IsRequested(i))
+            Request(i);
+    }
+
+    // Los preparados pasan a la lista de trozos; los que ya quedaron lejos se tiran
+    {
+        std::lock_guard<std::mutex> lock(readyMutex);
+        while (!ready.empty())
+        {
+            std::unique_ptr<ChunkData> data = std::move(ready.front());
+            ready.pop_front();
+            requested.erase(std::find(requested.begin(), requested.end(), data->index));
+            if (abs(data->index - focus) > settings.unloadDistance)
+                continue;
+
+            LoadedChunk& chunk = loaded[data->index];
+            chunk.data = std::move(data);
+            chunk.body = nullptr;
+            chunk.committed = 0;
+        }
+    }
+
+    // Primero se crean los trozos ms cercanos, una pieza a la vez
+    std::vector<int> order;
+    for (const auto& entry : loaded)
+        order.push_back(entry.first);
+    std::sort(order.begin(), order.end(), [focus](int a, int b) { return abs(a - focus) < abs(b - focus); });
+
+    b2FixtureDef def;
+    def.friction = settings.friction;
+    def.restitution = settings.restitution;
+    def.filter = CollisionLayers::GetFilter(LAYER_DEFAULT);
+    bool overBudget = false;
+    for (int index : order)
+    {
+        LoadedChunk& chunk = loaded[index];
+        while (chunk.committed < (int)chunk.data->pieces.size() && !overBudget)
+        {
+            if (chunk.body == nullptr)
+            {
+                b2Vec2 position = camera.ToLocal(chunk.data->originX, chunk.data->originY);
+                chunk.body = Box2DHelper::CreateBody(world, b2_staticBody, position, 0.0f);
+                bodiesCreated++;
+            }
+            def.shape = &chunk.data->pieces[chunk.committed];
+            chunk.body->CreateFixture(&def);
+            chunk.committed++;
+            overBudget = elapsedMs() >= settings.budgetMs;
+        }
+    }
+
+    // Con lo que queda del presupuesto se descargan los lejanos
+    for (auto it = loaded.begin(); it != loaded.end() && !overBudget; )
+    {
+        if (abs(it->first - focus) <= settings.unloadDistance)
+        {
+            ++it;
+            continue;
+        }
+        if (it->second.body != nullptr)
+        {
+            world->DestroyBody(it->second.body);
+            bodiesDestroyed++;
+        }
+        it = loaded.erase(it);
+        overBudget = elapsedMs() >= settings.budgetMs;
+    }
+
+    lastUpdateMs = elapsedMs();
+}
+
+// Solo las piezas que ya tienen fixture
+void ChunkStreamer::Draw(sf::RenderWindow* wnd, const Camera& camera) const
+{
+    for (const auto& entry : loaded)
+    {
+        const LoadedChunk& chunk = entry.second;
+        if (chunk.committed == 0)
+            continue;
+
+        b2Vec2 position = camera.ToLocal(chunk.data->originX, chunk.data->originY);
+        sf::Transform transform;
+        transform.translate(position.x, position.y);
+        wnd->draw(&chunk.data->vertices[0], chunk.committed * 6, sf::Triangles, sf::RenderStates(transform));
+    }
+}
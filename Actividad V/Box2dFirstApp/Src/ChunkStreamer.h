@@ -0,0 +1,106 @@
+//-----------------------------------------------------
+//Carga por trozos de la rampa sin fin. La rampa sigue
+//ms all del suelo de 500 en trozos de largo fijo que
+//se arman alrededor del objeto de control. Los hilos
+//del JobSystem preparan cada trozo (perfil, formas con
+//su cscara ya calculada y vrtices para dibujar) en
+//coordenadas globales del nivel, sin tocar el mundo.
+//Update, en el hilo principal y fuera de Step, crea los
+//bodies y fixtures de los trozos listos en tajadas de
+//tiempo acotado (un trozo puede quedar a medio crear
+//hasta el frame siguiente) y destruye los trozos que
+//quedaron lejos, as la carga no produce picos de frame
+//-----------------------------------------------------
+
+#pragma once
+#include <SFML/Graphics.hpp>
+#include <Box2D/Box2D.h>
+#include <atomic>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include "Camera.h"
+#include "JobSystem.h"
+
+// Forma y carga de la rampa
+struct ChunkSettings
+{
+	double startX, startY;		// punto de la superficie donde empieza el trozo 0 (global, unidades de render)
+	float angle;				// inclinacin de la rampa (rad)
+	float length;				// largo de cada trozo a lo largo de la rampa
+	int segments;				// piezas por trozo
+	float thickness;
+	float bumpHeight;			// amplitud de las ondulaciones de la superficie
+	float bumpLength;
+	float friction;
+	float restitution;
+	int loadAhead;				// trozos que se piden por delante del objeto de control
+	int loadBehind;
+	int unloadDistance;			// trozos a partir de los que se descarga (en cualquier sentido)
+	float budgetMs;				// tiempo por Update para crear y destruir bodies
+};
+
+class ChunkStreamer
+{
+private:
+	// Trozo preparado por un hilo del pool
+	struct ChunkData
+	{
+		int index;
+		double originX, originY;			// global, unidades de render
+		std::vector<b2PolygonShape> pieces;	// en metros, relativas al origen
+		std::vector<sf::Vertex> vertices;	// dos tringulos por pieza, relativos al origen
+	};
+
+	// Trozo en el mundo (o crendose)
+	struct LoadedChunk
+	{
+		std::unique_ptr<ChunkData> data;
+		b2Body* body;
+		int committed;			// piezas ya agregadas como fixtures
+	};
+
+	JobSystem* jobs;
+	ChunkSettings settings;
+	b2Vec2 along;			// direccin de la rampa (hacia abajo)
+	b2Vec2 up;				// normal de la superficie
+
+	// Preparados por los hilos, esperando al hilo principal
+	std::mutex readyMutex;
+	std::deque<std::unique_ptr<ChunkData>> ready;
+	std::atomic<int> inFlight;
+
+	// Solo del hilo principal
+	std::map<int, LoadedChunk> loaded;
+	std::vector<int> requested;
+	float lastUpdateMs;
+	int bodiesCreated;
+	int bodiesDestroyed;
+
+	void Surface(double s, double& x, double& y) const;
+	void Prepare(int index, ChunkData& data) const;
+	void Request(int index);
+	bool IsRequested(int index) const;
+	int FocusIndex(double x, double y) const;
+
+public:
+	ChunkStreamer(JobSystem* jobs, const ChunkSettings& settings);
+	~ChunkStreamer(void);
+
+	static ChunkSettings DefaultSettings();
+
+	// Pide los trozos cercanos a focus (global), crea los listos y descarga los
+	// lejanos dentro del presupuesto de tiempo. No se puede llamar durante Step
+	void Update(b2World* world, const Camera& camera, double focusX, double focusY);
+
+	// Dibuja los trozos en el mundo en la posicin local que les da la cmara
+	void Draw(sf::RenderWindow* wnd, const Camera& camera) const;
+
+	int GetLoadedCount() const { return (int)loaded.size(); }
+	int GetInFlightCount() const { return inFlight; }
+	float GetLastUpdateMs() const { return lastUpdateMs; }
+	int GetBodiesCreated() const { return bodiesCreated; }
+	int GetBodiesDestroyed() const { return bodiesDestroyed; }
+};
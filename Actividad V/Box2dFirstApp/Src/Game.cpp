@@ -7,6 +7,7 @@ Game::Game(int ancho, int alto, std::string titulo)
 {
     // Inicializacin de la ventana y configuracin de propiedades
     wnd = new RenderWindow(VideoMode(ancho, alto), titulo);
+    title = titulo;
     wnd->setVisible(true);
     fps = 60;
     wnd->setFramerateLimit(fps);
@@ -25,6 +26,7 @@ void Game::Loop()
         CheckCollitions(); // Comprobar colisiones
         UpdatePhysics(); // Actualizar la simulacin fsica
         DrawGame(); // Dibujar el juego
+        UpdateTitle(); // Mostrar los golpes en el ttulo
         wnd->display(); // Mostrar la ventana
     }
 
@@ -33,9 +35,17 @@ void Game::Loop()
 // Actualizacin de la simulacin fsica
 void Game::UpdatePhysics()
 {
-    phyWorld->Step(frameTime, 8, 8); // Simular el mundo fsico
+    lod->BeginStep(phyWorld, frameTime, camera->GetViewBounds()); // Estacionar o escalar las islas lejanas
+    phyWorld->Step(frameTime, 8, 3); // Simular el mundo fsico
+    lod->EndStep(); // Deshacer la escala de las islas que corrieron este paso
     phyWorld->ClearForces(); // Limpiar las fuerzas aplicadas a los cuerpos
-    phyWorld->DebugDraw(); // Dibujar el mundo fsico para depuracin
+    camera->Update(phyWorld, frameTime); // Seguir al objeto de control (puede correr el origen)
+
+    // Crear los trozos de rampa listos y descargar los lejanos (fuera de Step)
+    b2Vec2 controlPos = WorldUnits::ToUnits(controlBody->GetPosition());
+    chunks->Update(phyWorld, *camera, camera->GetGlobalX(controlPos), camera->GetGlobalY(controlPos));
+
+    debugRender->DrawWorld(phyWorld); // Dibujar lo visible del mundo fsico para depuracin
 }
 
 // Dibujo de los elementos del juego
@@ -47,20 +57,22 @@ void Game::DrawGame()
     groundShape.setFillColor(sf::Color::Red);
     // Se actualiza con la posicin y ngulo del groundBody
     {
-        b2Vec2 pos = groundBody->GetPosition();
+        b2Vec2 pos = WorldUnits::ToUnits(groundBody->GetPosition());
         float angle = groundBody->GetAngle();
         groundShape.setPosition(pos.x, pos.y);
         groundShape.setRotation(angle * 180.0f / b2_pi); // conversin a grados
     }
     wnd->draw(groundShape);
 
+    // Trozos de la rampa que siguen al suelo
+    chunks->Draw(wnd, *camera);
 
     // Objeto de control en SFML
     sf::RectangleShape controlShape(sf::Vector2f(10, 10));
     controlShape.setOrigin(5, 5); // centro
     controlShape.setFillColor(sf::Color::Magenta);
     {
-        b2Vec2 pos = controlBody->GetPosition();
+        b2Vec2 pos = WorldUnits::ToUnits(controlBody->GetPosition());
         float angle = controlBody->GetAngle();
         controlShape.setPosition(pos.x, pos.y);
         controlShape.setRotation(angle * 180.0f / b2_pi);
@@ -83,41 +95,127 @@ void Game::DoEvents()
     }
 }
 
-// Comprobacin de colisiones (a implementar ms adelante)
+// Comprobacin de colisiones: procesa en bloque los eventos del ltimo Step
 void Game::CheckCollitions()
 {
-    // Implementacin de la comprobacin de colisiones
+    // Vaciar la cola de contactos contando los golpes nuevos
+    contactQueue->Drain(0xFFFF, [this](const ContactEvent& evt)
+    {
+        if (evt.type == CONTACT_HIT)
+            impactCount++;
+    });
+}
+
+// Muestra los golpes en el ttulo; solo se cambia cuando hay golpes nuevos
+void Game::UpdateTitle()
+{
+    if (impactCount == shownImpactCount)
+        return;
+    shownImpactCount = impactCount;
+    wnd->setTitle(title + " - golpes: " + std::to_string(impactCount));
 }
 
 // Configuracin de la vista del juego
 void Game::SetZoom()
 {
-    View camara;
-    // Posicionamiento y tamao de la vista
-    camara.setSize(100.0f, 100.0f);
-    camara.setCenter(50.0f, 50.0f);
-    wnd->setView(camara); // Asignar la vista a la ventana
+    // Posicionamiento y tamao de la vista; la cmara la mueve despus
+    camera = new Camera(wnd, 100.0f, 100.0f);
+    camera->SetCenter(50.0f, 50.0f);
 }
 
 // Inicializacin del motor de fsica y los cuerpos del mundo fsico
 void Game::InitPhysics()
 {
-    // Inicializar el mundo fsico con la gravedad por defecto
-    phyWorld = new b2World(b2Vec2(0.0f, 9.8f));
+    // Inicializar el mundo fsico (la gravedad la define BuildScene)
+    phyWorld = new b2World(b2Vec2(0.0f, 0.0f));
 
     // Crear un renderer de debug para visualizar el mundo fsico
     debugRender = new SFMLRenderer(wnd);
     debugRender->SetFlags(UINT_MAX);
     phyWorld->SetDebugDraw(debugRender);
 
-    // Crear el suelo y las paredes estticas del mundo fsico
-    // Suelo: se crea un cuerpo esttico de 500x10, con origen en el centro y rotado 30(0.523599 rad)
-    groundBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 500, 10);
-    groundBody->SetTransform(b2Vec2(0.0f, 5.0f), 0.523599f); // Rotacin de 30
+    // Instalar la cola de eventos de contacto (se vaca en CheckCollitions)
+    contactQueue = new ContactQueue(4096);
+    phyWorld->SetContactListener(contactQueue);
+    phyWorld->SetDestructionListener(contactQueue);
+    impactCount = 0;
+    shownImpactCount = 0;
+
+    // Crear la escena (la misma que usa el barrido de parmetros)
+    controlBody = BuildScene(phyWorld, DefaultParams(), &groundBody);
+
+    // La cmara sigue al objeto de control mientras baja por la rampa
+    camera->SetTarget(controlBody);
+
+    // La rampa sigue por trozos despus del suelo, con el mismo material
+    SweepParams params = DefaultParams();
+    ChunkSettings settings = ChunkStreamer::DefaultSettings();
+    settings.friction = params.friction;
+    settings.restitution = params.restitution;
+    jobs = new JobSystem();
+    chunks = new ChunkStreamer(jobs, settings);
+
+    lod = new LodScheduler(LodScheduler::DefaultSettings());
+}
+
+// Valores con los que corre el juego: el suelo sin friccin y el objeto con
+// restitucin 0.5 (box2d combina la friccin con la media geomtrica y la
+// restitucin con el mximo, as que da lo mismo asignarlos a los dos fixtures)
+SweepParams Game::DefaultParams()
+{
+    SweepParams params;
+    params.gravity = 9.8f;
+    params.friction = 0.0f;
+    params.restitution = 0.5f;
+    params.velocityIterations = 8;
+    params.positionIterations = 3;
+    return params;
+}
+
+// Combinaciones del barrido: friccin y restitucin del plano inclinado,
+// gravedad e iteraciones del solver (11 x 4 x 3 x 2 = 264 mundos).
+// Con 30 el objeto debera quedar quieto a partir de friccin tan(30) = 0.577
+std::vector<SweepParams> Game::SweepGrid()
+{
+    const float restitutions[] = { 0.0f, 0.25f, 0.5f, 0.75f };
+    const float gravities[] = { 4.9f, 9.8f, 19.6f };
+    const int positionIterations[] = { 3, 8 };
+
+    std::vector<SweepParams> grid;
+    for (int f = 0; f <= 10; f++)
+        for (float restitution : restitutions)
+            for (float gravity : gravities)
+                for (int iterations : positionIterations)
+                {
+                    SweepParams params;
+                    params.gravity = gravity;
+                    params.friction = f * 0.1f;
+                    params.restitution = restitution;
+                    params.velocityIterations = 8;
+                    params.positionIterations = iterations;
+                    grid.push_back(params);
+                }
+    return grid;
+}
+
+// Creacin de la gravedad, el plano inclinado y el objeto de control en el mundo dado.
+// Devuelve el objeto de control y, si se pide, el suelo
+b2Body* Game::BuildScene(b2World* world, const SweepParams& params, b2Body** ground)
+{
+    world->SetGravity(WorldUnits::ToMeters(b2Vec2(0.0f, params.gravity)));
+
+    // Suelo: se crea un cuerpo esttico de 500x10, con origen en el centro y rotado 30(0.523599 rad).
+    // Se crea ya rotado en su lugar en vez de moverlo con SetTransform despus
+    b2Body* groundBody = Box2DHelper::CreateRectangularStaticBody(world, 500, 10, LAYER_DEFAULT, b2Vec2(0.0f, 5.0f), 0.523599f);
+    groundBody->GetFixtureList()->SetFriction(params.friction);
+    groundBody->GetFixtureList()->SetRestitution(params.restitution);
 
     // Crear el objeto de control
-    controlBody = Box2DHelper::CreateRectangularDynamicBody(phyWorld, 10, 10, 1.0f, 0.5f, 0.5f);
-    controlBody->SetTransform(b2Vec2(0.0f, 0.0f), 0.0f);;
+    b2Body* control = Box2DHelper::CreateRectangularDynamicBody(world, 10, 10, 1.0f, params.friction, params.restitution, LAYER_DEFAULT, b2Vec2(0.0f, 0.0f));
+
+    if (ground != nullptr)
+        *ground = groundBody;
+    return control;
 }
 
 // Destructor de la clase
@@ -2,6 +2,11 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
 #include "SFMLRenderer.h"
+#include "ContactQueue.h"
+#include "Camera.h"
+#include "Sweep.h"
+#include "ChunkStreamer.h"
+#include "LodScheduler.h"
 #include <list>
 
 using namespace sf;
@@ -19,6 +24,22 @@ private:
 
 	b2Body* rightWallBody;
 	SFMLRenderer *debugRender;
+	ContactQueue *contactQueue;
+
+	// Cmara que sigue al cuerpo de control y corre el origen del mundo
+	Camera *camera;
+
+	// Rampa sin fin: los trozos se preparan en los hilos del pool
+	JobSystem *jobs;
+	ChunkStreamer *chunks;
+
+	// Frecuencia de paso de cada isla segn su distancia a la vista
+	LodScheduler *lod;
+
+	// Golpes registrados por la cola de contactos, se muestran en el ttulo
+	int impactCount;
+	int shownImpactCount;
+	std::string title;
 
 	//tiempo de frame
 	float frameTime;
@@ -37,11 +58,17 @@ public:
 	~Game(void);
 	void InitPhysics();
 
+	// Escena y rango de parmetros compartidos con el barrido (no dependen de la ventana)
+	static SweepParams DefaultParams();
+	static std::vector<SweepParams> SweepGrid();
+	static b2Body* BuildScene(b2World* world, const SweepParams& params, b2Body** ground = nullptr);
+
 	// Main game loop
 	void Loop();
 	void DrawGame();
 	void UpdatePhysics();
 	void DoEvents();
 	void SetZoom();
+	void UpdateTitle();
 };
 
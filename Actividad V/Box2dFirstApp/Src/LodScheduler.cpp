@@ -0,0 +1,309 @@
+#include "LodScheduler.h"
+#include "Box2DHelper.h"
+#include <algorithm>
+#include <iostream>
+
+LodScheduler::LodScheduler(const LodSettings& settings)
+{
+    this->settings = settings;
+    stepIndex = 0;
+    nextPhase = 0;
+    timeStep = 0.0f;
+    fullBodySteps = 0;
+    coarseBodySteps = 0;
+    parkedBodySteps = 0;
+    promotions = 0;
+}
+
+LodSettings LodScheduler::DefaultSettings()
+{
+    LodSettings settings;
+    settings.nearDistance = 50.0f;
+    settings.farDistance = 150.0f;
+    settings.hysteresis = 20.0f;
+    settings.midRate = 2;
+    settings.farRate = 4;
+    return settings;
+}
+
+int LodScheduler::Find(int i)
+{
+    while (parent[i] != i)
+    {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+    return i;
+}
+
+void LodScheduler::Union(int a, int b)
+{
+    a = Find(a);
+    b = Find(b);
+    if (a != b)
+        parent[std::max(a, b)] = std::min(a, b);
+}
+
+// Frecuencia segn la distancia del AABB del body al rectngulo de la vista.
+// Para bajar de frecuencia hay que alejarse hysteresis ms
+int LodScheduler::DesiredRate(b2Body* body, const BodyState& state, const b2AABB& view) const
+{
+    b2AABB box;
+    box.lowerBound = body->GetPosition();
+    box.upperBound = body->GetPosition();
+    for (b2Fixture* f = body->GetFixtureList(); f; f = f->GetNext())
+        for (int32 child = 0; child < f->GetShape()->GetChildCount(); child++)
+            box.Combine(f->GetAABB(child));
+
+    b2Vec2 lower = WorldUnits::ToUnits(box.lowerBound);
+    b2Vec2 upper = WorldUnits::ToUnits(box.upperBound);
+    float dx = b2Max(0.0f, b2Max(view.lowerBound.x - upper.x, lower.x - view.upperBound.x));
+    float dy = b2Max(0.0f, b2Max(view.lowerBound.y - upper.y, lower.y - view.upperBound.y));
+    float distance = b2Max(dx, dy);
+
+    float nearLimit = settings.nearDistance + (state.rate == 1 ? settings.hysteresis : 0.0f);
+    float farLimit = settings.farDistance + (state.rate <= settings.midRate ? settings.hysteresis : 0.0f);
+    if (distance <= nearLimit)
+        return 1;
+    return distance <= farLimit ? settings.midRate : settings.farRate;
+}
+
+void LodScheduler::BeginStep(b2World* world, float timeStep, const b2AABB& view)
+{
+    this->timeStep = timeStep;
+    scaled.clear();
+    parked.clear();
+
+    // Bodies administrados: los dinmicos despiertos y los que estacion el scheduler.
+    // Los que durmi box2d no cuestan nada y se dejan como estn
+    for (auto& entry : states)
+        entry.second.seen = false;
+    bodies.clear();
+    indexOf.clear();
+    for (b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+    {
+        if (body->GetType() != b2_dynamicBody || !body->IsEnabled())
+            continue;
+
+        auto found = states.find(body);
+        if (found == states.end())
+        {
+            BodyState state;
+            state.rate = 1;
+            state.phase = nextPhase++;
+            state.parked = false;
+            state.savedVelocity.SetZero();
+            state.savedAngular = 0.0f;
+            state.gravityScale = body->GetGravityScale();
+            state.sleepTime = 0.0f;
+            found = states.insert(std::make_pair(body, state)).first;
+        }
+        found->second.seen = true;
+
+        if (body->IsAwake() || found->second.parked)
+        {
+            indexOf[body] = (int)bodies.size();
+            bodies.push_back(body);
+        }
+    }
+
+    for (auto it = states.begin(); it != states.end(); )
+        it = it->second.seen ? std::next(it) : states.erase(it);
+
+    // Islas como las arma box2d: contactos que se tocan y joints, sin pasar por estticos
+    parent.resize(bodies.size());
+    for (int i = 0; i < (int)bodies.size(); i++)
+        parent[i] = i;
+    for (b2Contact* c = world->GetContactList(); c; c = c->GetNext())
+    {
+        if (!c->IsTouching() || !c->IsEnabled() || c->GetFixtureA()->IsSensor() || c->GetFixtureB()->IsSensor())
+            continue;
+        auto a = indexOf.find(c->GetFixtureA()->GetBody());
+        auto b = indexOf.find(c->GetFixtureB()->GetBody());
+        if (a != indexOf.end() && b != indexOf.end())
+            Union(a->second, b->second);
+    }
+    for (b2Joint* j = world->GetJointList(); j; j = j->GetNext())
+    {
+        auto a = indexOf.find(j->GetBodyA());
+        auto b = indexOf.find(j->GetBodyB());
+        if (a != indexOf.end() && b != indexOf.end())
+            Union(a->second, b->second);
+    }
+
+    // Frecuencia de la isla: la menor de sus bodies (una isla que toca un body
+    // de paso completo corre a paso completo). La fase es la de la raz
+    std::vector<int> islandRate(bodies.size(), settings.farRate);
+    std::vector<float> islandSleep(bodies.size(), b2_maxFloat);
+    for (int i = 0; i < (int)bodies.size(); i++)
+    {
+        const BodyState& state = states[bodies[i]];
+        int root = Find(i);
+        islandRate[root] = std::min(islandRate[root], DesiredRate(bodies[i], state, view));
+        islandSleep[root] = std::min(islandSleep[root], state.sleepTime);
+    }
+
+    for (int i = 0; i < (int)bodies.size(); i++)
+    {
+        b2Body* body = bodies[i];
+        BodyState& state = states[body];
+        int root = Find(i);
+        int rate = islandRate[root];
+        state.rate = rate;
+
+        // Una isla lenta el tiempo que pide box2d se duerme como lo hara box2d
+        if (rate > 1 && islandSleep[root] >= b2_timeToSleep)
+        {
+            body->SetAwake(false);
+            state.parked = false;
+            state.sleepTime = 0.0f;
+            continue;
+        }
+
+        bool active = rate == 1 || (stepIndex + states[bodies[root]].phase) % rate == 0;
+        if (active)
+        {
+            b2Vec2 v = state.parked ? state.savedVelocity : body->GetLinearVelocity();
+            float w = state.parked ? state.savedAngular : body->GetAngularVelocity();
+            if (state.parked)
+            {
+                body->SetAwake(true);
+                state.parked = false;
+            }
+            if (rate == 1)
+            {
+                body->SetLinearVelocity(v);
+                body->SetAngularVelocity(w);
+                state.sleepTime = 0.0f;
+                fullBodySteps++;
+                continue;
+            }
+
+            // Un paso de dt con v*N y g*N*N avanza lo mismo que un paso de N*dt
+            state.gravityScale = body->GetGravityScale();
+            body->SetLinearVelocity((float)rate * v);
+            body->SetAngularVelocity((float)rate * w);
+            body->SetGravityScale(state.gravityScale * rate * rate);
+            scaled.push_back(body);
+            coarseBodySteps++;
+        }
+        else
+        {
+            if (!state.parked)
+            {
+                state.savedVelocity = body->GetLinearVelocity();
+                state.savedAngular = body->GetAngularVelocity();
+                state.parked = true;
+                body->SetAwake(false);
+            }
+            parked.push_back(body);
+            parkedBodySteps++;
+        }
+    }
+
+    stepIndex++;
+}
+
+void LodScheduler::EndStep()
+{
+    for (b2Body* body : scaled)
+    {
+        BodyState& state = states[body];
+        float inverse = 1.0f / state.rate;
+        body->SetLinearVelocity(inverse * body->GetLinearVelocity());
+        body->SetAngularVelocity(inverse * body->GetAngularVelocity());
+        body->SetGravityScale(state.gravityScale);
+
+        bool slow = body->GetLinearVelocity().LengthSquared() <= b2_linearSleepTolerance * b2_linearSleepTolerance
+            && b2Abs(body->GetAngularVelocity()) <= b2_angularSleepTolerance;
+        state.sleepTime = slow ? state.sleepTime + state.rate * timeStep : 0.0f;
+    }
+
+    // box2d despierta con velocidad 0 a los bodies dormidos que toca una isla
+    // activa: lo que tienen ahora es el cambio del paso y se suma a la guardada
+    for (b2Body* body : parked)
+    {
+        if (!body->IsAwake())
+            continue;
+        BodyState& state = states[body];
+        body->SetLinearVelocity(state.savedVelocity + body->GetLinearVelocity());
+        body->SetAngularVelocity(state.savedAngular + body->GetAngularVelocity());
+        state.parked = false;
+        state.rate = 1;
+        state.sleepTime = 0.0f;
+        promotions++;
+    }
+}
+
+// Tambin se saca de las listas del paso, por si se destruye entre BeginStep y EndStep
+void LodScheduler::Forget(b2Body* body)
+{
+    states.erase(body);
+    scaled.erase(std::remove(scaled.begin(), scaled.end(), body), scaled.end());
+    parked.erase(std::remove(parked.begin(), parked.end(), body), parked.end());
+}
+
+int LodScheduler::GetRate(b2Body* body) const
+{
+    auto found = states.find(body);
+    return found != states.end() ? found->second.rate : 1;
+}
+
+// Suelo de 500 con paredes y pelotas repartidas a lo largo (unidades de render)
+static void BuildBenchmarkLevel(b2World* world, int ballCount)
+{
+    Box2DHelper::CreateRectangularStaticBody(world, 500, 10, LAYER_DEFAULT, b2Vec2(0.0f, 100.0f));
+    Box2DHelper::CreateRectangularStaticBody(world, 10, 100, LAYER_DEFAULT, b2Vec2(-255.0f, 50.0f));
+    Box2DHelper::CreateRectangularStaticBody(world, 10, 100, LAYER_DEFAULT, b2Vec2(255.0f, 50.0f));
+
+    unsigned int seed = 12345;
+    for (int i = 0; i < ballCount; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        float x = -240.0f + 480.0f * ((seed >> 8) % 10000) / 10000.0f;
+        seed = seed * 1664525u + 1013904223u;
+        float y = 10.0f + 80.0f * ((seed >> 8) % 10000) / 10000.0f;
+        b2Body* ball = Box2DHelper::CreateCircularDynamicBody(world, 2, 1.0f, 0.2f, 0.9f, LAYER_DEFAULT, b2Vec2(x, y));
+        ball->SetLinearVelocity(WorldUnits::ToMeters(b2Vec2(x > 0.0f ? -10.0f : 10.0f, 0.0f)));
+    }
+}
+
+// Mismo nivel y misma vista (100x100 en el centro) con todo a paso completo y con el scheduler
+void LodScheduler::RunBenchmark(int ballCount, int steps)
+{
+    const float timeStep = 1.0f / 60.0f;
+    b2AABB view;
+    view.lowerBound.Set(-50.0f, 0.0f);
+    view.upperBound.Set(50.0f, 100.0f);
+
+    b2World full(WorldUnits::ToMeters(b2Vec2(0.0f, 9.8f)));
+    BuildBenchmarkLevel(&full, ballCount);
+    b2Timer timer;
+    for (int step = 0; step < steps; step++)
+    {
+        full.Step(timeStep, 8, 3);
+        full.ClearForces();
+    }
+    float fullMs = timer.GetMilliseconds();
+
+    b2World lod(WorldUnits::ToMeters(b2Vec2(0.0f, 9.8f)));
+    BuildBenchmarkLevel(&lod, ballCount);
+    LodScheduler scheduler(DefaultSettings());
+    timer.Reset();
+    for (int step = 0; step < steps; step++)
+    {
+        scheduler.BeginStep(&lod, timeStep, view);
+        lod.Step(timeStep, 8, 3);
+        scheduler.EndStep();
+        lod.ClearForces();
+    }
+    float lodMs = timer.GetMilliseconds();
+
+    std::cout << ballCount << " pelotas en 500 de ancho, vista de 100, " << steps << " pasos" << std::endl;
+    std::cout << "  paso completo: " << fullMs / steps << " ms/paso" << std::endl;
+    std::cout << "  con scheduler: " << lodMs / steps << " ms/paso, por paso "
+        << (float)scheduler.GetFullBodySteps() / steps << " bodies a paso completo, "
+        << (float)scheduler.GetCoarseBodySteps() / steps << " escalados, "
+        << (float)scheduler.GetParkedBodySteps() / steps << " estacionados, "
+        << scheduler.GetPromotionCount() << " promovidos por contacto" << std::endl;
+}
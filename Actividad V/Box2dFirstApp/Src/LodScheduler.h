@@ -0,0 +1,100 @@
+//-----------------------------------------------------
+//Pasos a distinta frecuencia segn la distancia a la
+//vista. Box2d integra todo el mundo con el mismo dt, as
+//que las islas lejanas se "estacionan": en los pasos
+//que no les tocan se duermen (guardando su velocidad),
+//y box2d no gasta nada en bodies dormidos. En su paso,
+//una isla de frecuencia 1/N se despierta con la
+//velocidad multiplicada por N y la escala de gravedad
+//por N*N, lo que equivale a un paso de N*dt; EndStep
+//divide la velocidad otra vez. Las fases se reparten
+//entre las islas para que el costo no se junte en un
+//mismo paso. Una isla vuelve a paso completo cuando se
+//acerca a la vista o cuando toca un body de paso
+//completo (queda en su isla, o box2d la despierta
+//durante un paso en que estaba estacionada)
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <unordered_map>
+#include <vector>
+
+// Distancias (unidades de render, medidas desde el borde de la vista) y frecuencias
+struct LodSettings
+{
+	float nearDistance;		// hasta ac paso completo
+	float farDistance;		// hasta ac 1 de cada midRate pasos, despus 1 de cada farRate
+	float hysteresis;		// distancia extra antes de bajar de frecuencia
+	int midRate;
+	int farRate;
+};
+
+class LodScheduler
+{
+private:
+	struct BodyState
+	{
+		int rate;				// 1, midRate o farRate
+		int phase;				// paso dentro del ciclo en el que le toca
+		bool parked;			// dormido por el scheduler (no por box2d)
+		b2Vec2 savedVelocity;	// en metros, mientras est estacionado
+		float savedAngular;
+		float gravityScale;		// original, mientras corre escalado
+		float sleepTime;		// tiempo lento acumulado en sus pasos (box2d no lo cuenta: se reinicia al despertar)
+		bool seen;
+	};
+
+	LodSettings settings;
+	std::unordered_map<b2Body*, BodyState> states;
+
+	// Islas del paso actual (union-find sobre los bodies administrados)
+	std::vector<b2Body*> bodies;
+	std::vector<int> parent;
+	std::unordered_map<b2Body*, int> indexOf;
+
+	// Bodies escalados o estacionados en este paso, para EndStep
+	std::vector<b2Body*> scaled;
+	std::vector<b2Body*> parked;
+	float timeStep;
+
+	unsigned stepIndex;
+	int nextPhase;
+
+	// Contadores desde la creacin
+	long long fullBodySteps;
+	long long coarseBodySteps;
+	long long parkedBodySteps;
+	int promotions;
+
+	int Find(int i);
+	void Union(int a, int b);
+	int DesiredRate(b2Body* body, const BodyState& state, const b2AABB& view) const;
+
+public:
+	LodScheduler(const LodSettings& settings);
+
+	static LodSettings DefaultSettings();
+
+	// Antes de Step: arma las islas, decide la frecuencia de cada una y
+	// despierta (escaladas) o estaciona sus bodies. view en unidades de render
+	void BeginStep(b2World* world, float timeStep, const b2AABB& view);
+
+	// Despus de Step: deshace la escala y sube a paso completo las islas
+	// que box2d despert por un contacto con una isla activa
+	void EndStep();
+
+	// Descarta el estado del body. Hay que llamarlo antes de b2World::DestroyBody:
+	// el estado se guarda por direccin y el allocator de box2d puede darle la misma
+	// a un body nuevo, que heredara la velocidad guardada y la escala de gravedad
+	void Forget(b2Body* body);
+
+	int GetRate(b2Body* body) const;
+	long long GetFullBodySteps() const { return fullBodySteps; }
+	long long GetCoarseBodySteps() const { return coarseBodySteps; }
+	long long GetParkedBodySteps() const { return parkedBodySteps; }
+	int GetPromotionCount() const { return promotions; }
+
+	// Pelotas rebotando en un nivel de 500 de ancho, con y sin el scheduler
+	static void RunBenchmark(int ballCount, int steps);
+};
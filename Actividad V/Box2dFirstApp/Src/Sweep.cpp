@@ -0,0 +1,129 @@
+#include "Sweep.h"
+#include "Game.h"
+#include "JobSystem.h"
+#include "WorldUnits.h"
+#include <iostream>
+#include <iomanip>
+
+// Velocidad debajo de la cual se considera que el cuerpo est quieto (unidades de render/s)
+#define SWEEP_REST_SPEED 0.5f
+// Pasos seguidos por debajo de esa velocidad para darlo por asentado
+#define SWEEP_REST_STEPS 30
+
+// Simula todo el barrido en paralelo y muestra la tabla
+void Sweep::Run(int steps)
+{
+    std::vector<SweepParams> grid = Game::SweepGrid();
+    std::vector<SweepResult> results(grid.size());
+
+    JobSystem jobs;
+    b2Timer timer;
+
+    // Cada mundo es independiente: un trabajo por mundo y cada uno escribe solo su resultado
+    jobs.ParallelFor((int)grid.size(), 1, [&grid, &results, steps](int begin, int end)
+    {
+        for (int i = begin; i < end; i++)
+            results[i] = RunWorld(grid[i], steps);
+    });
+
+    float wallMs = timer.GetMilliseconds();
+    float serialMs = 0.0f;
+
+    PrintHeader();
+    for (const SweepResult& result : results)
+    {
+        PrintRow(result);
+        serialMs += result.runMs;
+    }
+
+    std::cout << std::endl << grid.size() << " mundos de " << steps << " pasos en "
+        << jobs.GetThreadCount() << " hilos: " << wallMs << " ms ("
+        << serialMs << " ms sumando cada mundo)" << std::endl;
+}
+
+// Un mundo del barrido
+SweepResult Sweep::RunWorld(const SweepParams& params, int steps)
+{
+    const float timeStep = 1.0f / 60.0f;
+
+    b2World world(b2Vec2(0.0f, 0.0f));
+    b2Body* body = Game::BuildScene(&world, params);
+
+    SweepResult result;
+    result.params = params;
+    result.settleTime = -1.0f;
+    result.initialEnergy = Energy(body, world.GetGravity());
+
+    b2Timer timer;
+    int restSteps = 0;
+    for (int step = 0; step < steps; step++)
+    {
+        world.Step(timeStep, params.velocityIterations, params.positionIterations);
+
+        // El cuerpo se da por asentado cuando duerme o va lento varios pasos seguidos
+        float speed = WorldUnits::ToUnits(body->GetLinearVelocity().Length());
+        if (!body->IsAwake() || speed < SWEEP_REST_SPEED)
+        {
+            if (++restSteps == SWEEP_REST_STEPS && result.settleTime < 0.0f)
+                result.settleTime = (step + 1 - SWEEP_REST_STEPS) * timeStep;
+        }
+        else
+        {
+            restSteps = 0;
+            result.settleTime = -1.0f;
+        }
+    }
+    result.runMs = timer.GetMilliseconds();
+
+    result.finalPosition = WorldUnits::ToUnits(body->GetPosition());
+    result.finalEnergy = Energy(body, world.GetGravity());
+    return result;
+}
+
+// Energa cintica (traslacin y rotacin) ms potencial respecto del origen
+float Sweep::Energy(const b2Body* body, const b2Vec2& gravity)
+{
+    b2Vec2 v = body->GetLinearVelocity();
+    float w = body->GetAngularVelocity();
+    float kinetic = 0.5f * body->GetMass() * b2Dot(v, v) + 0.5f * body->GetInertia() * w * w;
+    float potential = -body->GetMass() * b2Dot(gravity, body->GetWorldCenter());
+    return kinetic + potential;
+}
+
+// Encabezado de la tabla
+void Sweep::PrintHeader()
+{
+    std::cout << std::right
+        << std::setw(8) << "g"
+        << std::setw(8) << "fric"
+        << std::setw(8) << "rest"
+        << std::setw(6) << "iter"
+        << std::setw(12) << "asentado s"
+        << std::setw(20) << "posicion (x, y)"
+        << std::setw(12) << "E inicial"
+        << std::setw(12) << "E final"
+        << std::setw(10) << "ms" << std::endl;
+}
+
+// Una fila de la tabla
+void Sweep::PrintRow(const SweepResult& result)
+{
+    std::cout << std::right << std::fixed << std::setprecision(2)
+        << std::setw(8) << result.params.gravity
+        << std::setw(8) << result.params.friction
+        << std::setw(8) << result.params.restitution
+        << std::setw(3) << result.params.velocityIterations
+        << "/" << std::setw(2) << result.params.positionIterations
+        << std::setw(12);
+
+    if (result.settleTime < 0.0f)
+        std::cout << "-";
+    else
+        std::cout << result.settleTime;
+
+    std::cout << std::setw(10) << result.finalPosition.x
+        << std::setw(10) << result.finalPosition.y
+        << std::setw(12) << result.initialEnergy
+        << std::setw(12) << result.finalEnergy
+        << std::setw(10) << result.runMs << std::endl;
+}
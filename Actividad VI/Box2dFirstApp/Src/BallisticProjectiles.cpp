@@ -0,0 +1,186 @@
+#include "BallisticProjectiles.h"
+#include "Box2DHelper.h"
+#include "WorldUnits.h"
+
+BallisticProjectiles::BallisticProjectiles(b2World* world, float radius, CollisionLayer layer, int capacity)
+{
+    this->world = world;
+    this->capacity = capacity;
+    circle.m_p.SetZero();
+    circle.m_radius = WorldUnits::ToMeters(radius);
+    this->layer = layer;
+    filter = CollisionLayers::GetFilter(layer);
+    hitCount = 0;
+
+    posX.reserve(capacity);
+    posY.reserve(capacity);
+    velX.reserve(capacity);
+    velY.reserve(capacity);
+    prevX.reserve(capacity);
+    prevY.reserve(capacity);
+    hit.reserve(capacity);
+}
+
+bool BallisticProjectiles::Fire(b2Vec2 position, b2Vec2 velocity)
+{
+    if ((int)posX.size() >= capacity)
+        return false;
+
+    b2Vec2 p = WorldUnits::ToMeters(position);
+    b2Vec2 v = WorldUnits::ToMeters(velocity);
+    posX.push_back(p.x);
+    posY.push_back(p.y);
+    velX.push_back(v.x);
+    velY.push_back(v.y);
+    prevX.push_back(p.x);
+    prevY.push_back(p.y);
+    hit.push_back(0);
+    return true;
+}
+
+// El ltimo disparo ocupa el lugar del quitado
+void BallisticProjectiles::Remove(int i)
+{
+    int last = (int)posX.size() - 1;
+    posX[i] = posX[last];
+    posY[i] = posY[last];
+    velX[i] = velX[last];
+    velY[i] = velY[last];
+    prevX[i] = prevX[last];
+    prevY[i] = prevY[last];
+    hit[i] = hit[last];
+    posX.pop_back();
+    posY.pop_back();
+    velX.pop_back();
+    velY.pop_back();
+    prevX.pop_back();
+    prevY.pop_back();
+    hit.pop_back();
+}
+
+// Tiro con gravedad constante: p += v dt + g dt/2 y v += g dt (exacto para cualquier dt).
+// Los disparos que ya chocaron esperan quietos a Promote
+int BallisticProjectiles::Step(float dt)
+{
+    int count = (int)posX.size();
+    if (count == 0)
+        return 0;
+
+    b2Vec2 g = world->GetGravity();
+    float halfDt2 = 0.5f * dt * dt;
+    float* px = &posX[0];
+    float* py = &posY[0];
+    float* vx = &velX[0];
+    float* vy = &velY[0];
+    float* ox = &prevX[0];
+    float* oy = &prevY[0];
+    for (int i = 0; i < count; i++)
+    {
+        float moving = hit[i] ? 0.0f : 1.0f;
+        ox[i] = px[i];
+        oy[i] = py[i];
+        px[i] += moving * (vx[i] * dt + g.x * halfDt2);
+        py[i] += moving * (vy[i] * dt + g.y * halfDt2);
+        vx[i] += moving * g.x * dt;
+        vy[i] += moving * g.y * dt;
+    }
+
+    int hits = 0;
+    for (int i = 0; i < count; i++)
+    {
+        if (!hit[i] && Sweep(i))
+            hits++;
+    }
+    hitCount += hits;
+    return hits;
+}
+
+// Barre el tramo del ltimo Step. Si choca, deja el disparo en el punto del choque
+bool BallisticProjectiles::Sweep(int i)
+{
+    SweepQuery query;
+    query.owner = this;
+    query.from.Set(prevX[i], prevY[i]);
+    query.translation.Set(posX[i] - prevX[i], posY[i] - prevY[i]);
+    query.lambda = 1.0f;
+
+    b2Vec2 to = query.from + query.translation;
+    b2Vec2 r(circle.m_radius, circle.m_radius);
+    b2AABB aabb;
+    aabb.lowerBound = b2Min(query.from, to) - r;
+    aabb.upperBound = b2Max(query.from, to) + r;
+    world->QueryAABB(&query, aabb);
+
+    if (query.lambda >= 1.0f)
+        return false;
+
+    b2Vec2 stop = query.from + query.lambda * query.translation;
+    posX[i] = stop.x;
+    posY[i] = stop.y;
+    hit[i] = 1;
+    return true;
+}
+
+// Candidato del broadphase: mismo filtro que box2d y cast del crculo contra cada hijo del shape
+bool BallisticProjectiles::SweepQuery::ReportFixture(b2Fixture* fixture)
+{
+    if (fixture->IsSensor())
+        return true;
+    const b2Filter& other = fixture->GetFilterData();
+    if ((owner->filter.maskBits & other.categoryBits) == 0 || (owner->filter.categoryBits & other.maskBits) == 0)
+        return true;
+
+    b2ShapeCastInput input;
+    input.transformA = fixture->GetBody()->GetTransform();
+    input.transformB.Set(from, 0.0f);
+    input.proxyB.Set(&owner->circle, 0);
+    input.translationB = translation;
+
+    const b2Shape* shape = fixture->GetShape();
+    for (int32 child = 0; child < shape->GetChildCount(); child++)
+    {
+        input.proxyA.Set(shape, child);
+        b2ShapeCastOutput output;
+        if (b2ShapeCast(&output, &input) && output.lambda < lambda)
+            lambda = output.lambda;
+    }
+    return true;
+}
+
+int BallisticProjectiles::Promote(float density, float friction, float restitution, std::vector<b2Body*>& promoted)
+{
+    if (hitCount == 0)
+        return 0;
+
+    float radius = WorldUnits::ToUnits(circle.m_radius);
+    int created = 0;
+    for (int i = (int)posX.size() - 1; i >= 0; i--)
+    {
+        if (!hit[i])
+            continue;
+
+        b2Vec2 position = WorldUnits::ToUnits(b2Vec2(posX[i], posY[i]));
+        b2Body* body = Box2DHelper::CreateCircularDynamicBody(world, radius, density, friction, restitution, layer, position);
+        body->SetLinearVelocity(b2Vec2(velX[i], velY[i]));
+        promoted.push_back(body);
+        Remove(i);
+        created++;
+    }
+    hitCount = 0;
+    return created;
+}
+
+int BallisticProjectiles::RemoveBeyond(float maxX)
+{
+    float limit = WorldUnits::ToMeters(maxX);
+    int removed = 0;
+    for (int i = (int)posX.size() - 1; i >= 0; i--)
+    {
+        if (posX[i] > limit && !hit[i])
+        {
+            Remove(i);
+            removed++;
+        }
+    }
+    return removed;
+}
@@ -0,0 +1,77 @@
+//-----------------------------------------------------
+//Proyectiles balsticos sin body. Mientras un disparo
+//vuela por espacio vaco no necesita fixture, contactos
+//ni solver: su posicin sale de la frmula del tiro con
+//gravedad constante y se guarda en arreglos paralelos.
+//Step integra todos los disparos en una pasada y despus
+//barre el tramo recorrido por cada uno contra el
+//broadphase del mundo (una consulta del AABB del tramo y,
+//solo si hay candidatos, un b2ShapeCast del crculo
+//contra cada fixture que su capa acepta). Los que chocan
+//con algo quedan en el punto del choque y Promote los
+//convierte en bodies reales para que box2d resuelva el
+//rebote; el resto sigue sin costarle nada al b2World
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <Box2D/b2_distance.h>
+#include <vector>
+#include "CollisionLayers.h"
+
+class BallisticProjectiles
+{
+private:
+	b2World* world;
+	b2CircleShape circle;		// forma del disparo en metros, centrada en el origen
+	CollisionLayer layer;
+	b2Filter filter;			// filtro de la capa de los disparos
+
+	// Estado de cada disparo (metros y metros por segundo)
+	std::vector<float> posX;
+	std::vector<float> posY;
+	std::vector<float> velX;
+	std::vector<float> velY;
+	std::vector<float> prevX;	// posicin al empezar el ltimo Step
+	std::vector<float> prevY;
+	std::vector<uint8> hit;		// choc en el ltimo Step y espera a Promote
+	int capacity;
+	int hitCount;
+
+	// Barrido de un disparo: candidatos del broadphase y el choque ms cercano
+	struct SweepQuery : public b2QueryCallback
+	{
+		BallisticProjectiles* owner;
+		b2Vec2 from;
+		b2Vec2 translation;
+		float lambda;			// fraccin del tramo hasta el choque ms cercano
+		bool ReportFixture(b2Fixture* fixture) override;
+	};
+
+	bool Sweep(int i);
+	void Remove(int i);
+
+public:
+	// radius en unidades de render
+	BallisticProjectiles(b2World* world, float radius, CollisionLayer layer, int capacity);
+
+	// Agrega un disparo (position y velocity en unidades de render). Devuelve false si no hay lugar
+	bool Fire(b2Vec2 position, b2Vec2 velocity);
+
+	// Avanza dt segundos con la gravedad del mundo y barre cada tramo contra el broadphase.
+	// No se puede llamar durante b2World::Step. Devuelve cuntos disparos chocaron
+	int Step(float dt);
+
+	// Crea un body por cada disparo que choc, en el punto del choque y con su velocidad,
+	// y lo quita del arreglo. Los bodies nuevos quedan al final de promoted
+	int Promote(float density, float friction, float restitution, std::vector<b2Body*>& promoted);
+
+	// Quita los disparos que pasaron de maxX (en unidades de render)
+	int RemoveBeyond(float maxX);
+
+	int GetCount() const { return (int)posX.size(); }
+	int GetCapacity() const { return capacity; }
+	float GetRadius() const { return circle.m_radius; }
+	const float* GetPositionX() const { return posX.empty() ? nullptr : &posX[0]; }
+	const float* GetPositionY() const { return posY.empty() ? nullptr : &posY[0]; }
+};
@@ -0,0 +1,778 @@
+#include "Benchmark.h"
+#include "Game.h"
+#include "Box2DHelper.h"
+#include "JobSystem.h"
+#include "RenderBatch.h"
+#include "BodyIndex.h"
+#include "TreeMonitor.h"
+#include "FatteningProbe.h"
+#include "TeleportBatch.h"
+#include "BallisticProjectiles.h"
+#include "ParticleSwarm.h"
+#include <iostream>
+#include <iomanip>
+#include <thread>
+#include <vector>
+#include <memory>
+
+// Corre todas las configuraciones y muestra la tabla
+void Benchmark::RunAll()
+{
+    // Antes: unidades de render directo en box2d con 8/8 iteraciones.
+    // Despus: escena en metros con las iteraciones recomendadas por box2d
+    BenchmarkConfig configs[] =
+    {
+        { "render 1:1, 8/8", 1.0f, 8, 8, 1200 },
+        { "metros, 8/8", UNITS_PER_METER, 8, 8, 1200 },
+        { "metros, 8/3", UNITS_PER_METER, 8, 3, 1200 },
+    };
+
+    PrintHeader();
+    for (const BenchmarkConfig& config : configs)
+        PrintRow(config, RunProjectileScene(config));
+
+    std::cout << std::endl;
+    RunFrameScaling(4000, 300);
+
+    std::cout << std::endl;
+    RunRenderPrep(30000, 120);
+
+    std::cout << std::endl;
+    RunBodyScan(20000, 100000, 300);
+
+    std::cout << std::endl;
+    RunMortonOrder(4000, 20000, 300);
+
+    std::cout << std::endl;
+    RunTreeMonitor(4000, 20000, 300, 0.5f);
+
+    std::cout << std::endl;
+    RunFattening(200, 1200);
+
+    std::cout << std::endl;
+    RunTeleport(5000, 60);
+
+    std::cout << std::endl;
+    RunBallistic(4000, 600);
+
+    std::cout << std::endl;
+    RunSwarm(50000, 5000, 300);
+}
+
+// Arma, avanza y mide las dos pasadas; el mundo de cada pasada se destruye
+// despus de report
+void Benchmark::RunPasses(int steps,
+    const std::function<void(b2World& world, int pass)>& setup,
+    const std::function<void(b2World& world, int pass, int step)>& step,
+    const std::function<void(int pass, float msPerStep)>& report)
+{
+    for (int pass = 0; pass < 2; pass++)
+    {
+        b2World world(b2Vec2(0.0f, 0.0f));
+        setup(world, pass);
+
+        b2Timer timer;
+        for (int i = 0; i < steps; i++)
+            step(world, pass, i);
+        report(pass, timer.GetMilliseconds() / steps);
+    }
+}
+
+// Caja de 500x300 unidades con el suelo y dos paredes, ya en su lugar
+static void BuildSwarmBox(b2World* world)
+{
+    world->SetGravity(WorldUnits::ToMeters(b2Vec2(0.0f, 9.8f)));
+    Box2DHelper::CreateRectangularStaticBody(world, 500, 10, LAYER_STATIC, b2Vec2(250.0f, 305.0f));
+    Box2DHelper::CreateRectangularStaticBody(world, 10, 300, LAYER_STATIC, b2Vec2(-5.0f, 150.0f));
+    Box2DHelper::CreateRectangularStaticBody(world, 10, 300, LAYER_STATIC, b2Vec2(505.0f, 150.0f));
+}
+
+// Lugar de la partcula i en un bloque que cae sobre el suelo
+static b2Vec2 SwarmSlot(int i)
+{
+    return b2Vec2(5.0f + (i % 240) * 2.05f, 290.0f - (i / 240) * 2.05f);
+}
+
+// Crculos de radio 1 cayendo en una caja: rigidCount bodies de box2d contra
+// particleCount partculas de ParticleSwarm, con 20 bodies dinmicos en el medio
+// del enjambre para el acople en los dos sentidos
+void Benchmark::RunSwarm(int particleCount, int rigidCount, int steps)
+{
+    const float timeStep = 1.0f / 60.0f;
+    std::cout << "circulos de radio 1 en una caja, " << steps << " pasos" << std::endl;
+
+    int count = 0;
+    std::unique_ptr<ParticleSwarm> swarm;
+    RunPasses(steps, [&](b2World& world, int pass)
+    {
+        BuildSwarmBox(&world);
+        for (int i = 0; i < 20; i++)
+            Box2DHelper::CreateRectangularDynamicBody(&world, 10, 10, 1.0f, 0.3f, 0.1f, LAYER_DYNAMIC, b2Vec2(20.0f + i * 24.0f, 120.0f));
+
+        count = pass == 0 ? rigidCount : particleCount;
+        swarm.reset(new ParticleSwarm(&world, 1.0f, 1.0f, 0.1f, LAYER_DYNAMIC, particleCount));
+        for (int i = 0; i < count; i++)
+        {
+            if (pass == 0)
+                Box2DHelper::CreateCircularDynamicBody(&world, 1, 1.0f, 0.3f, 0.1f, LAYER_DYNAMIC, SwarmSlot(i));
+            else
+                swarm->Add(SwarmSlot(i), b2Vec2(0.0f, 0.0f));
+        }
+    },
+    [&](b2World& world, int pass, int)
+    {
+        world.Step(timeStep, 8, 3);
+        if (pass == 1)
+            swarm->Step(timeStep);
+    },
+    [&](int pass, float ms)
+    {
+        std::cout << (pass == 0 ? "bodies:    " : "enjambre:  ") << std::setw(6) << count << " circulos, "
+            << std::fixed << std::setprecision(3) << ms << " ms/paso, "
+            << ms * 1000.0f / count << " ms cada 1000";
+        if (pass == 1)
+            std::cout << " (" << swarm->GetPairCount() << " pares)";
+        std::cout << std::endl;
+    });
+}
+
+// Oleada de shotCount disparos a la vez desde una columna delante del lanzador:
+// como bodies (lo que haca el juego) y como disparos balsticos que reciben
+// un body solo al chocar. Cuenta Step ms la integracin, el barrido y el
+// descarte de los que salen de la pantalla
+void Benchmark::RunBallistic(int shotCount, int steps)
+{
+    const float timeStep = 1.0f / 60.0f;
+    std::cout << shotCount << " disparos en vuelo, " << steps << " pasos" << std::endl;
+
+    std::vector<b2Body*> bodies;
+    std::unique_ptr<BallisticProjectiles> ballistic;
+    int promotedCount = 0;
+    RunPasses(steps, [&](b2World& world, int pass)
+    {
+        Game::BuildScene(&world);
+
+        bodies.clear();
+        ballistic.reset(new BallisticProjectiles(&world, 2.0f, LAYER_PROJECTILE, shotCount));
+        promotedCount = 0;
+        for (int i = 0; i < shotCount; i++)
+        {
+            b2Vec2 position(15.0f + (i / 80) * 2.0f, 10.0f + (i % 80) * 1.0f);
+            b2Vec2 velocity(90.0f, (float)(i % 7) - 3.0f);
+            if (pass == 0)
+            {
+                b2Body* body = Box2DHelper::CreateCircularDynamicBody(&world, 2, 2, 1.0f, 0.5f, LAYER_PROJECTILE, position);
+                body->SetLinearVelocity(WorldUnits::ToMeters(velocity));
+                bodies.push_back(body);
+            }
+            else
+                ballistic->Fire(position, velocity);
+        }
+    },
+    [&](b2World& world, int pass, int)
+    {
+        world.Step(timeStep, 8, 3);
+        if (pass == 1)
+        {
+            ballistic->RemoveBeyond(800.0f);
+            ballistic->Step(timeStep);
+            promotedCount += ballistic->Promote(2.0f, 1.0f, 0.5f, bodies);
+        }
+
+        // Mismo criterio de descarte que el juego
+        for (size_t i = 0; i < bodies.size(); )
+        {
+            if (WorldUnits::ToUnits(bodies[i]->GetPosition()).x > 800.0f)
+            {
+                world.DestroyBody(bodies[i]);
+                bodies[i] = bodies.back();
+                bodies.pop_back();
+            }
+            else
+                i++;
+        }
+    },
+    [&](int pass, float ms)
+    {
+        std::cout << (pass == 0 ? "bodies:     " : "balisticos: ")
+            << std::fixed << std::setprecision(3) << ms << " ms/paso";
+        if (pass == 1)
+            std::cout << " (" << promotedCount << " pasaron a body al chocar)";
+        std::cout << std::endl;
+    });
+}
+
+// Destino en la oleada de un body: una grilla de columnas que se recorre salteada
+static b2Vec2 WaveSlot(int i, int count, int wave)
+{
+    int slot = (int)(((long long)i * 7919 + wave * 104729) % count);
+    return b2Vec2(20.0f + (slot % 100) * 5.0f, 10.0f + (slot / 100) * 5.0f);
+}
+
+void Benchmark::RunTeleport(int bodyCount, int waves)
+{
+    const float timeStep = 1.0f / 60.0f;
+    std::cout << bodyCount << " bodies, " << waves << " oleadas de reubicacion" << std::endl;
+
+    std::vector<b2Body*> bodies(bodyCount);
+    TeleportBatch batch(bodyCount * 2);
+    float createMs = 0.0f;
+    float teleportMs = 0.0f;
+    float stepMs = 0.0f;
+    RunPasses(waves, [&](b2World& world, int pass)
+    {
+        // Creacin: origen y SetTransform (como antes) o directo en su lugar
+        b2Timer timer;
+        for (int i = 0; i < bodyCount; i++)
+        {
+            b2Vec2 position = WaveSlot(i, bodyCount, 0);
+            if (pass == 0)
+            {
+                bodies[i] = Box2DHelper::CreateCircularDynamicBody(&world, 2, 2, 1.0f, 0.5f, LAYER_PROJECTILE);
+                bodies[i]->SetTransform(WorldUnits::ToMeters(position), 0.0f);
+            }
+            else
+                bodies[i] = Box2DHelper::CreateCircularDynamicBody(&world, 2, 2, 1.0f, 0.5f, LAYER_PROJECTILE, position);
+        }
+        createMs = timer.GetMilliseconds();
+        world.Step(timeStep, 8, 3);
+        teleportMs = 0.0f;
+        stepMs = 0.0f;
+    },
+    // Cada oleada manda todos los bodies a un lugar de reaparicin y la
+    // mitad se corrige enseguida a su lugar final (dos teletransportes)
+    [&](b2World& world, int pass, int step)
+    {
+        int wave = step + 1;
+        b2Timer timer;
+        for (int i = 0; i < bodyCount; i++)
+        {
+            b2Vec2 spawn = WaveSlot(i, bodyCount, wave);
+            if (pass == 0)
+                bodies[i]->SetTransform(WorldUnits::ToMeters(spawn), 0.0f);
+            else
+                batch.Teleport(bodies[i], spawn, 0.0f);
+        }
+        for (int i = 0; i < bodyCount; i += 2)
+        {
+            b2Vec2 target = WaveSlot(i, bodyCount, wave + waves);
+            if (pass == 0)
+                bodies[i]->SetTransform(WorldUnits::ToMeters(target), 0.0f);
+            else
+                batch.Teleport(bodies[i], target, 0.0f);
+        }
+        if (pass == 1)
+            batch.Apply();
+        teleportMs += timer.GetMilliseconds();
+
+        timer.Reset();
+        world.Step(timeStep, 8, 3);
+        stepMs += timer.GetMilliseconds();
+    },
+    [&](int pass, float)
+    {
+        std::cout << (pass == 0 ? "SetTransform directo: " : "TeleportBatch:        ")
+            << std::fixed << std::setprecision(3)
+            << "crear " << createMs << " ms, reubicar " << teleportMs / waves
+            << " ms/oleada, paso siguiente " << stepMs / waves << " ms";
+        if (pass == 1)
+            std::cout << " (" << batch.GetAppliedCount() / waves << " SetTransform y "
+                << batch.GetSkippedCount() / waves << " descartados por oleada)";
+        std::cout << std::endl;
+    });
+}
+
+void Benchmark::RunFattening(int restingCount, int steps)
+{
+    const float timeStep = 1.0f / 60.0f;
+    b2World world(b2Vec2(0.0f, 0.0f));
+    b2Body* control = Game::BuildScene(&world);
+
+    // Bodies quietos apoyados en el suelo (dos filas entre x = 15 y x = 95)
+    int columns = restingCount / 2 + 1;
+    for (int i = 0; i < restingCount; i++)
+    {
+        b2Body* body = Box2DHelper::CreateCircularDynamicBody(&world, 1, 1.0f, 0.5f, 0.1f);
+        float x = 15.0f + 80.0f * (i % columns) / columns;
+        float y = i < columns ? 94.0f : 92.0f;
+        body->SetTransform(WorldUnits::ToMeters(b2Vec2(x, y)), 0.0f);
+    }
+
+    FatteningProbe probe(&world, timeStep, FatteningProbe::DefaultPolicy());
+    std::vector<b2Body*> projectiles;
+    float direction = 1.0f;
+
+    for (int step = 0; step < steps; step++)
+    {
+        // Misma entrada simulada que RunProjectileScene
+        b2Vec2 controlPos = WorldUnits::ToUnits(control->GetPosition());
+        if (controlPos.y >= 90.0f)
+            direction = -1.0f;
+        else if (controlPos.y <= 10.0f)
+            direction = 1.0f;
+        control->SetLinearVelocity(WorldUnits::ToMeters(b2Vec2(0.0f, 30.0f * direction)));
+        if (step % 4 == 0 && (int)projectiles.size() < MAX_PROJECTILES)
+            projectiles.push_back(Game::CreateProjectile(&world, control));
+
+        world.Step(timeStep, 8, 3);
+        world.ClearForces();
+        probe.Observe();
+
+        for (size_t i = 0; i < projectiles.size(); )
+        {
+            if (WorldUnits::ToUnits(projectiles[i]->GetPosition()).x > 800.0f)
+            {
+                world.DestroyBody(projectiles[i]);
+                projectiles[i] = projectiles.back();
+                projectiles.pop_back();
+            }
+            else
+                i++;
+        }
+    }
+
+    std::cout << restingCount << " bodies quietos y disparos continuos, " << steps << " pasos" << std::endl;
+    probe.Print();
+}
+
+// Pila de crculos sobre un suelo. Cada lugar de la grilla se ocupa en orden
+// al azar y churn altas y bajas ms lo vuelven a desordenar, as el orden de
+// creacin (el de la lista de bodies y de los nodos del rbol) no tiene que
+// ver con la posicin
+void Benchmark::BuildChurnedPile(b2World* world, int bodyCount, int churn, std::vector<b2Body*>& bodies)
+{
+    world->SetGravity(WorldUnits::ToMeters(b2Vec2(0.0f, 10.0f)));
+    int columns = (int)sqrtf((float)bodyCount) + 1;
+    b2Body* ground = Box2DHelper::CreateRectangularStaticBody(world, columns * 2.5f + 20.0f, 10);
+    ground->SetTransform(WorldUnits::ToMeters(b2Vec2(columns * 1.25f, 5.0f)), 0.0f);
+
+    std::vector<int> slots(bodyCount);
+    for (int i = 0; i < bodyCount; i++)
+        slots[i] = i;
+    unsigned int seed = 4242;
+    for (int i = bodyCount - 1; i > 0; i--)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        std::swap(slots[i], slots[(seed >> 8) % (i + 1)]);
+    }
+
+    auto create = [world, columns](int slot)
+    {
+        b2Body* body = Box2DHelper::CreateCircularDynamicBody(world, 1, 1.0f, 0.5f, 0.1f);
+        body->SetTransform(WorldUnits::ToMeters(b2Vec2(2.5f * (slot % columns), -2.5f * (slot / columns))), 0.0f);
+        body->GetUserData().pointer = (uintptr_t)slot;
+        return body;
+    };
+
+    bodies.clear();
+    for (int slot : slots)
+        bodies.push_back(create(slot));
+
+    for (int i = 0; i < churn; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        int victim = (int)((seed >> 8) % bodies.size());
+        int slot = (int)bodies[victim]->GetUserData().pointer;
+        world->DestroyBody(bodies[victim]);
+        bodies[victim] = create(slot);
+    }
+}
+
+void Benchmark::RunMortonOrder(int bodyCount, int churn, int steps)
+{
+    const float timeStep = 1.0f / 60.0f;
+    const int warmup = 30;
+    float ms[2];
+    float reorderMs = 0.0f;
+    std::cout << bodyCount << " bodies en pila despues de " << churn << " bajas y altas, "
+        << steps << " pasos" << std::endl;
+
+    RunPasses(steps, [&](b2World& world, int pass)
+    {
+        std::vector<b2Body*> bodies;
+        BuildChurnedPile(&world, bodyCount, churn, bodies);
+
+        b2Timer timer;
+        if (pass == 1)
+        {
+            // Lo mismo que hace TreeMonitor al reconstruir, todo de una vez
+            BodyIndex::SortMorton(bodies);
+            for (b2Body* body : bodies)
+            {
+                body->SetEnabled(false);
+                body->SetEnabled(true);
+            }
+        }
+        reorderMs = timer.GetMilliseconds();
+
+        for (int step = 0; step < warmup; step++)
+            world.Step(timeStep, 8, 3);
+    },
+    [&](b2World& world, int, int)
+    {
+        world.Step(timeStep, 8, 3);
+    },
+    [&](int pass, float msPerStep)
+    {
+        ms[pass] = msPerStep;
+        std::cout << (pass == 0 ? "orden de creacion: " : "curva Z:           ")
+            << std::fixed << std::setprecision(3) << ms[pass] << " ms/paso";
+        if (pass == 1)
+            std::cout << " (reinsertar " << reorderMs << " ms, mejora " << std::setprecision(2) << ms[0] / ms[1] << "x)";
+        std::cout << std::endl;
+    });
+}
+
+// Igual que el juego: TreeMonitor mide cada 60 pasos y reinserta con el
+// tiempo libre que se le da. Al final se muestran sus contadores
+void Benchmark::RunTreeMonitor(int bodyCount, int churn, int steps, float idleMs)
+{
+    const float timeStep = 1.0f / 60.0f;
+    b2World world(b2Vec2(0.0f, 0.0f));
+    std::vector<b2Body*> bodies;
+    BuildChurnedPile(&world, bodyCount, churn, bodies);
+
+    TreeMonitor monitor(&world, 60, 2.0f);
+    TreeStats initial = monitor.GetStats();
+    for (int step = 0; step < steps; step++)
+    {
+        world.Step(timeStep, 8, 3);
+        monitor.AfterStep(idleMs);
+    }
+
+    const TreeStats& before = monitor.GetStatsBeforeRebuild();
+    const TreeStats& after = monitor.GetStats();
+    std::cout << bodyCount << " bodies en pila, " << steps << " pasos con "
+        << idleMs << " ms libres" << std::endl;
+    std::cout << "arbol inicial: calidad " << initial.quality << ", altura " << initial.height << std::endl;
+    if (monitor.GetRebuildCount() == 0)
+    {
+        std::cout << "sin reconstrucciones" << std::endl;
+        return;
+    }
+    std::cout << monitor.GetRebuildCount() << " reconstrucciones, " << monitor.GetTotalRebuildMs() << " ms en total" << std::endl;
+    std::cout << "ultima: calidad " << before.quality << " -> " << after.quality
+        << ", altura " << before.height << " -> " << after.height
+        << ", " << monitor.GetLastReinserted() << " bodies en " << monitor.GetLastRebuildFrames() << " frames ("
+        << monitor.GetLastSkipped() << " salteados por estar tocando), " << monitor.GetLastRebuildMs() << " ms" << std::endl;
+}
+
+// Crea bodies y destruye al azar churn veces, as la lista de bodies queda
+// desparramada en los bloques del allocator como despus de una sesin larga.
+// Despus mide una pasada de lgica (contar los que pasan de un x) por la
+// lista enlazada y por el ndice denso, con el costo de Sync incluido
+void Benchmark::RunBodyScan(int bodyCount, int churn, int frames)
+{
+    b2World world(b2Vec2(0.0f, 0.0f));
+    BodyIndex index(bodyCount);
+    std::vector<b2Body*> bodies;
+    unsigned int seed = 12345;
+
+    for (int i = 0; i < bodyCount + churn; i++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        if ((int)bodies.size() >= bodyCount || (!bodies.empty() && (seed >> 16) % 3 == 0))
+        {
+            int victim = (int)((seed >> 8) % bodies.size());
+            index.Remove(bodies[victim]);
+            world.DestroyBody(bodies[victim]);
+            bodies[victim] = bodies.back();
+            bodies.pop_back();
+            continue;
+        }
+
+        b2Body* body = Box2DHelper::CreateCircularDynamicBody(&world, 1, 1.0f, 0.5f, 0.1f);
+        body->SetTransform(WorldUnits::ToMeters(b2Vec2((float)((seed >> 16) % 1000), (float)((seed >> 4) % 1000))), 0.0f);
+        body->SetLinearVelocity(b2Vec2(1.0f, 0.0f));
+        bodies.push_back(body);
+        index.Add(body);
+    }
+    while ((int)bodies.size() < bodyCount)
+    {
+        bodies.push_back(Box2DHelper::CreateCircularDynamicBody(&world, 1, 1.0f, 0.5f, 0.1f));
+        index.Add(bodies.back());
+    }
+
+    float limit = WorldUnits::ToMeters(500.0f);
+    int listHits = 0;
+    int indexHits = 0;
+
+    b2Timer timer;
+    for (int frame = 0; frame < frames; frame++)
+        for (b2Body* body = world.GetBodyList(); body; body = body->GetNext())
+            if (body->GetPosition().x > limit)
+                listHits++;
+    float listMs = timer.GetMilliseconds() / frames;
+
+    timer.Reset();
+    for (int frame = 0; frame < frames; frame++)
+    {
+        index.Sync();
+        const float* x = index.GetPositionX();
+        for (int i = 0; i < index.GetCount(); i++)
+            if (x[i] > limit)
+                indexHits++;
+    }
+    float indexMs = timer.GetMilliseconds() / frames;
+
+    std::cout << index.GetCount() << " bodies despues de " << churn << " altas y bajas" << std::endl;
+    std::cout << std::fixed << std::setprecision(4)
+        << "  GetBodyList: " << listMs << " ms/pasada" << std::endl
+        << "  BodyIndex (Sync + pasada): " << indexMs << " ms/pasada" << std::endl;
+    if (listHits != indexHits)
+        std::cout << "  distinto resultado: " << listHits << " / " << indexHits << std::endl;
+}
+
+// Mundo sin pasos con shapeCount cajas y crculos en grilla; solo se mide la
+// preparacin del dibujo (Gather en el hilo principal y Build en paralelo)
+void Benchmark::RunRenderPrep(int shapeCount, int frames)
+{
+    b2World world(b2Vec2(0.0f, 0.0f));
+    int columns = (int)sqrtf((float)shapeCount) + 1;
+    for (int i = 0; i < shapeCount; i++)
+    {
+        b2Vec2 pos = WorldUnits::ToMeters(b2Vec2(5.0f * (i % columns), 5.0f * (i / columns)));
+        b2Body* body = i % 2 == 0
+            ? Box2DHelper::CreateRectangularDynamicBody(&world, 2, 2, 1.0f, 0.5f, 0.1f)
+            : Box2DHelper::CreateCircularDynamicBody(&world, 1, 1.0f, 0.5f, 0.1f);
+        body->SetTransform(pos, 0.1f * i);
+    }
+
+    int maxThreads = (int)std::thread::hardware_concurrency();
+    if (maxThreads < 1)
+        maxThreads = 1;
+
+    RenderBatch batch(1024);
+    std::cout << shapeCount << " shapes, " << frames << " frames" << std::endl;
+    std::cout << std::setw(6) << "hilos" << std::setw(12) << "ms/frame"
+        << std::setw(12) << "gather ms" << std::setw(10) << "mejora" << std::setw(10) << "vertices" << std::endl;
+
+    float serialMs = 0.0f;
+    for (int threads = 1; threads <= maxThreads; threads++)
+    {
+        JobSystem jobs(threads);
+        int parts = threads * 2;
+        float totalMs = 0.0f;
+        float gatherMs = 0.0f;
+
+        for (int frame = 0; frame < frames; frame++)
+        {
+            b2Timer timer;
+            batch.Gather(&world);
+            gatherMs += timer.GetMilliseconds();
+            jobs.ParallelFor(parts, 1, [&batch, parts](int begin, int end)
+            {
+                for (int part = begin; part < end; part++)
+                    batch.Build(part, parts);
+            });
+            totalMs += timer.GetMilliseconds();
+        }
+
+        float msPerFrame = totalMs / frames;
+        if (threads == 1)
+            serialMs = msPerFrame;
+
+        std::cout << std::setw(6) << threads << std::fixed << std::setprecision(3)
+            << std::setw(12) << msPerFrame << std::setw(12) << gatherMs / frames
+            << std::setprecision(2) << std::setw(9) << serialMs / msPerFrame << "x"
+            << std::setw(10) << batch.GetVertexCount() << std::endl;
+    }
+}
+
+// Mismo grafo que Game::RunFrameGraph con muchos ms proyectiles que el juego.
+// La fsica es una sola tarea, as que la mejora con ms hilos sale de la
+// lgica y de la preparacin del dibujo que corren en paralelo despus del paso
+void Benchmark::RunFrameScaling(int projectileCount, int frames)
+{
+    int maxThreads = (int)std::thread::hardware_concurrency();
+    if (maxThreads < 1)
+        maxThreads = 1;
+
+    std::cout << projectileCount << " proyectiles, " << frames << " frames" << std::endl;
+    std::cout << std::setw(6) << "hilos" << std::setw(12) << "ms/frame"
+        << std::setw(12) << "peor ms" << std::setw(10) << "mejora" << std::endl;
+
+    float serialMs = 0.0f;
+    for (int threads = 1; threads <= maxThreads; threads++)
+    {
+        JobSystem jobs(threads);
+        b2World world(b2Vec2(0.0f, 0.0f));
+        b2Body* control = Game::BuildScene(&world);
+        ContactQueue contacts(4096);
+        world.SetContactListener(&contacts);
+
+        // Proyectiles repartidos a lo alto de la escena (no chocan entre s)
+        std::vector<b2Body*> bodies(projectileCount);
+        for (int i = 0; i < projectileCount; i++)
+        {
+            float y = 10.0f + 80.0f * i / projectileCount;
+            control->SetTransform(WorldUnits::ToMeters(b2Vec2(0.0f, y)), 0.0f);
+            bodies[i] = Game::CreateProjectile(&world, control);
+        }
+
+        std::vector<sf::Vertex> vertices(projectileCount * PROJECTILE_VERTICES);
+        int hits = 0;
+        int expired = 0;
+        float totalMs = 0.0f;
+        float worstMs = 0.0f;
+
+        for (int frame = 0; frame < frames; frame++)
+        {
+            b2Timer timer;
+
+            JobSystem::TaskHandle physics = jobs.CreateTask([&world]
+            {
+                world.Step(1.0f / 60.0f, 8, 3);
+                world.ClearForces();
+            });
+            JobSystem::TaskHandle logic = jobs.CreateTask([&]
+            {
+                hits += contacts.Drain(CollisionLayers::GetCategoryBits(LAYER_PROJECTILE), [](const ContactEvent&) {});
+                for (b2Body* body : bodies)
+                    if (WorldUnits::ToUnits(body->GetPosition()).x > 800.0f)
+                        expired++;
+            });
+            jobs.AddDependency(logic, physics);
+            jobs.Run(logic);
+
+            for (int begin = 0; begin < projectileCount; begin += PROJECTILE_CHUNK)
+            {
+                int end = b2Min(begin + PROJECTILE_CHUNK, projectileCount);
+                JobSystem::TaskHandle task = jobs.CreateTask([&bodies, &vertices, begin, end]
+                {
+                    Game::BuildProjectileVertices(&bodies[0], begin, end, &vertices[0]);
+                });
+                jobs.AddDependency(task, physics);
+                jobs.Run(task);
+            }
+
+            jobs.Run(physics);
+            jobs.Wait();
+
+            float ms = timer.GetMilliseconds();
+            totalMs += ms;
+            worstMs = b2Max(worstMs, ms);
+        }
+
+        float msPerFrame = totalMs / frames;
+        if (threads == 1)
+            serialMs = msPerFrame;
+
+        std::cout << std::setw(6) << threads << std::fixed << std::setprecision(3)
+            << std::setw(12) << msPerFrame << std::setw(12) << worstMs
+            << std::setprecision(2) << std::setw(9) << serialMs / msPerFrame << "x" << std::endl;
+    }
+}
+
+// Corre la escena de proyectiles con una entrada simulada
+BenchmarkResult Benchmark::RunProjectileScene(const BenchmarkConfig& config)
+{
+    float savedScale = WorldUnits::GetUnitsPerMeter();
+    WorldUnits::SetUnitsPerMeter(config.unitsPerMeter);
+
+    b2World world(b2Vec2(0.0f, 0.0f));
+    b2Body* control = Game::BuildScene(&world);
+
+    std::vector<b2Body*> projectiles;
+    projectiles.reserve(MAX_PROJECTILES);
+    b2Body* probe = nullptr;
+
+    BenchmarkResult result;
+    result.msPerStep = 0.0f;
+    result.maxStepMs = 0.0f;
+    result.solveMs = 0.0f;
+    result.solveTOIMs = 0.0f;
+    result.maxBodies = 0;
+    result.maxContacts = 0;
+    result.probePosition.SetZero();
+
+    const float timeStep = 1.0f / 60.0f;
+    float direction = 1.0f;
+    float totalMs = 0.0f;
+
+    for (int step = 0; step < config.steps; step++)
+    {
+        // Entrada simulada: el lanzador sube y baja entre los lmites del juego
+        b2Vec2 controlPos = WorldUnits::ToUnits(control->GetPosition());
+        if (controlPos.y >= 90.0f)
+            direction = -1.0f;
+        else if (controlPos.y <= 10.0f)
+            direction = 1.0f;
+        control->SetLinearVelocity(WorldUnits::ToMeters(b2Vec2(0.0f, 30.0f * direction)));
+
+        // Un disparo cada 4 pasos mientras haya lugar
+        if (step % 4 == 0 && (int)projectiles.size() < MAX_PROJECTILES)
+        {
+            projectiles.push_back(Game::CreateProjectile(&world, control));
+            if (probe == nullptr)
+                probe = projectiles.back();
+        }
+
+        b2Timer timer;
+        world.Step(timeStep, config.velocityIterations, config.positionIterations);
+        float ms = timer.GetMilliseconds();
+        world.ClearForces();
+
+        totalMs += ms;
+        result.maxStepMs = b2Max(result.maxStepMs, ms);
+        result.solveMs += world.GetProfile().solve;
+        result.solveTOIMs += world.GetProfile().solveTOI;
+        result.maxBodies = b2Max(result.maxBodies, (int)world.GetBodyCount());
+        result.maxContacts = b2Max(result.maxContacts, (int)world.GetContactCount());
+
+        // Mismo criterio de descarte que el juego
+        for (size_t i = 0; i < projectiles.size(); )
+        {
+            b2Vec2 pos = WorldUnits::ToUnits(projectiles[i]->GetPosition());
+            if (pos.x > 800.0f)
+            {
+                if (projectiles[i] == probe)
+                {
+                    result.probePosition = pos;
+                    probe = nullptr;
+                }
+                world.DestroyBody(projectiles[i]);
+                projectiles[i] = projectiles.back();
+                projectiles.pop_back();
+            }
+            else
+                i++;
+        }
+    }
+
+    if (probe != nullptr)
+        result.probePosition = WorldUnits::ToUnits(probe->GetPosition());
+    result.msPerStep = totalMs / config.steps;
+
+    WorldUnits::SetUnitsPerMeter(savedScale);
+    return result;
+}
+
+// Encabezado de la tabla
+void Benchmark::PrintHeader()
+{
+    std::cout << std::left << std::setw(18) << "config"
+        << std::right << std::setw(10) << "ms/paso"
+        << std::setw(10) << "peor ms"
+        << std::setw(10) << "solve ms"
+        << std::setw(10) << "toi ms"
+        << std::setw(8) << "bodies"
+        << std::setw(10) << "contactos"
+        << std::setw(22) << "testigo (x, y)" << std::endl;
+}
+
+// Una fila de la tabla
+void Benchmark::PrintRow(const BenchmarkConfig& config, const BenchmarkResult& result)
+{
+    std::cout << std::left << std::setw(18) << config.name
+        << std::right << std::fixed << std::setprecision(3)
+        << std::setw(10) << result.msPerStep
+        << std::setw(10) << result.maxStepMs
+        << std::setw(10) << result.solveMs
+        << std::setw(10) << result.solveTOIMs
+        << std::setw(8) << result.maxBodies
+        << std::setw(10) << result.maxContacts
+        << std::setprecision(1)
+        << std::setw(12) << result.probePosition.x
+        << std::setw(10) << result.probePosition.y << std::endl;
+}
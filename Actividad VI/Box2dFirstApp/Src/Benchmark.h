@@ -0,0 +1,99 @@
+//-----------------------------------------------------
+//Benchmarks sin ventana de la escena de la Actividad VI.
+//Corren la misma escena que el juego (Game::BuildScene)
+//con una entrada simulada y muestran por consola una
+//tabla con el costo por paso y la posicin final de un
+//proyectil testigo, para comprobar que la jugabilidad
+//no cambia entre configuraciones. RunFrameScaling corre
+//el grafo de tareas del frame (fsica, lgica y dibujo)
+//con 1 a N hilos y muestra el tiempo de frame por hilos;
+//RunRenderPrep hace lo mismo solo con RenderBatch y
+//RunBodyScan compara recorrer GetBodyList con BodyIndex;
+//RunMortonOrder mide Step antes y despus de reinsertar
+//los proxies en orden de curva Z, RunTreeMonitor deja
+//que TreeMonitor reconstruya el rbol de a lotes y
+//muestra sus contadores y RunFattening cuenta
+//reinserciones y pares falsos con el engorde de box2d y
+//con uno adaptivo. RunTeleport
+//reubica oleadas de bodies con SetTransform directo y
+//con TeleportBatch. RunBallistic compara una oleada de
+//disparos como bodies y como BallisticProjectiles;
+//RunSwarm compara crculos como bodies y en ParticleSwarm
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <vector>
+#include <functional>
+
+// Configuracin de una corrida
+struct BenchmarkConfig
+{
+	const char* name;
+	float unitsPerMeter;		// escala de WorldUnits durante la corrida
+	int velocityIterations;
+	int positionIterations;
+	int steps;
+};
+
+// Resultado de una corrida
+struct BenchmarkResult
+{
+	float msPerStep;		// promedio de b2World::Step
+	float maxStepMs;		// peor paso
+	float solveMs;			// tiempo total del solver (b2Profile::solve)
+	float solveTOIMs;		// tiempo total de CCD (b2Profile::solveTOI)
+	int maxBodies;
+	int maxContacts;
+	b2Vec2 probePosition;	// posicin final del primer proyectil, en unidades de render
+};
+
+class Benchmark
+{
+public:
+	// Corre todas las configuraciones y muestra la tabla
+	static void RunAll();
+
+	// Corre la escena de proyectiles con la configuracin dada
+	static BenchmarkResult RunProjectileScene(const BenchmarkConfig& config);
+
+	// Dos pasadas de una escena, cada una en un mundo nuevo: la 0 como antes y la 1
+	// con el cambio a medir. setup arma la escena de la pasada, step avanza un paso
+	// (world.Step incluido) y report recibe los ms por paso de step. El estado de
+	// cada pasada vive en variables del llamador que setup vuelve a inicializar
+	static void RunPasses(int steps,
+		const std::function<void(b2World& world, int pass)>& setup,
+		const std::function<void(b2World& world, int pass, int step)>& step,
+		const std::function<void(int pass, float msPerStep)>& report);
+
+	// Frame completo sin ventana con projectileCount proyectiles, de 1 hilo a uno por ncleo
+	static void RunFrameScaling(int projectileCount, int frames);
+
+	// Gather y Build de RenderBatch con shapeCount shapes, de 1 hilo a uno por ncleo
+	static void RunRenderPrep(int shapeCount, int frames);
+
+	// Pasada por las posiciones de bodyCount bodies despus de churn altas y bajas
+	static void RunBodyScan(int bodyCount, int churn, int frames);
+
+	// Dos mundos iguales y desordenados por churn; en uno se reinsertan los proxies por curva Z
+	static void RunMortonOrder(int bodyCount, int churn, int steps);
+	static void BuildChurnedPile(b2World* world, int bodyCount, int churn, std::vector<b2Body*>& bodies);
+
+	// La misma pila con TreeMonitor reconstruyendo con idleMs libres por paso
+	static void RunTreeMonitor(int bodyCount, int churn, int steps, float idleMs);
+
+	// Escena del juego con una fila de bodies quietos sobre el suelo y disparos continuos
+	static void RunFattening(int restingCount, int steps);
+
+	// Oleadas que reubican bodyCount bodies (algunos dos veces) antes de cada Step
+	static void RunTeleport(int bodyCount, int waves);
+
+	// Oleada de shotCount disparos simultneos, con body o balsticos
+	static void RunBallistic(int shotCount, int steps);
+
+	// rigidCount crculos como bodies contra particleCount partculas del enjambre
+	static void RunSwarm(int particleCount, int rigidCount, int steps);
+
+	static void PrintHeader();
+	static void PrintRow(const BenchmarkConfig& config, const BenchmarkResult& result);
+};
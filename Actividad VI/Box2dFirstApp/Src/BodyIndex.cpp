@@ -0,0 +1,194 @@
+#include "BodyIndex.h"
+#include <algorithm>
+#include <utility>
+
+// Constructor: reserva lugar para capacity bodies
+BodyIndex::BodyIndex(int capacity)
+{
+    bodies.reserve(capacity);
+    tags.reserve(capacity);
+    posX.reserve(capacity);
+    posY.reserve(capacity);
+    angle.reserve(capacity);
+    velX.reserve(capacity);
+    velY.reserve(capacity);
+    awake.reserve(capacity);
+    awakeCount = 0;
+}
+
+int BodyIndex::IndexOf(b2Body* body)
+{
+    return (int)body->GetUserData().pointer - 1;
+}
+
+void BodyIndex::Add(b2Body* body, int tag)
+{
+    body->GetUserData().pointer = (uintptr_t)bodies.size() + 1;
+    bodies.push_back(body);
+    tags.push_back(tag);
+    posX.push_back(0.0f);
+    posY.push_back(0.0f);
+    angle.push_back(0.0f);
+    velX.push_back(0.0f);
+    velY.push_back(0.0f);
+    awake.push_back(1);
+    Copy((int)bodies.size() - 1);
+    awakeCount++;
+}
+
+// Saca el body moviendo el ltimo a su lugar (el orden no se conserva)
+void BodyIndex::Remove(b2Body* body)
+{
+    int i = IndexOf(body);
+    if (i < 0)
+        return;
+
+    int last = (int)bodies.size() - 1;
+    if (awake[i])
+        awakeCount--;
+    if (i != last)
+    {
+        bodies[i] = bodies[last];
+        tags[i] = tags[last];
+        posX[i] = posX[last];
+        posY[i] = posY[last];
+        angle[i] = angle[last];
+        velX[i] = velX[last];
+        velY[i] = velY[last];
+        awake[i] = awake[last];
+        bodies[i]->GetUserData().pointer = (uintptr_t)i + 1;
+    }
+
+    bodies.pop_back();
+    tags.pop_back();
+    posX.pop_back();
+    posY.pop_back();
+    angle.pop_back();
+    velX.pop_back();
+    velY.pop_back();
+    awake.pop_back();
+    body->GetUserData().pointer = 0;
+}
+
+// Copia el estado de un body
+void BodyIndex::Copy(int i)
+{
+    const b2Body* body = bodies[i];
+    const b2Transform& xf = body->GetTransform();
+    const b2Vec2& v = body->GetLinearVelocity();
+    posX[i] = xf.p.x;
+    posY[i] = xf.p.y;
+    angle[i] = body->GetAngle();
+    velX[i] = v.x;
+    velY[i] = v.y;
+}
+
+void BodyIndex::Sync()
+{
+    awakeCount = 0;
+    int count = (int)bodies.size();
+    for (int i = 0; i < count; i++)
+    {
+        const b2Body* body = bodies[i];
+        uint8 active = body->IsAwake() && body->IsEnabled() ? 1 : 0;
+
+        // Dormido desde antes: la copia sigue valiendo
+        if (active || awake[i])
+            Copy(i);
+        awake[i] = active;
+        awakeCount += active;
+    }
+}
+
+// Separa los 16 bits bajos de v dejando un cero entre cada uno
+static uint32 SpreadBits(uint32 v)
+{
+    v &= 0x0000ffff;
+    v = (v | (v << 8)) & 0x00ff00ff;
+    v = (v | (v << 4)) & 0x0f0f0f0f;
+    v = (v | (v << 2)) & 0x33333333;
+    v = (v | (v << 1)) & 0x55555555;
+    return v;
+}
+
+uint32 BodyIndex::MortonCode(float x, float y, const b2AABB& bounds)
+{
+    b2Vec2 size = bounds.upperBound - bounds.lowerBound;
+    float u = size.x > 0.0f ? (x - bounds.lowerBound.x) / size.x : 0.0f;
+    float v = size.y > 0.0f ? (y - bounds.lowerBound.y) / size.y : 0.0f;
+    uint32 ix = (uint32)(b2Clamp(u, 0.0f, 1.0f) * 65535.0f);
+    uint32 iy = (uint32)(b2Clamp(v, 0.0f, 1.0f) * 65535.0f);
+    return SpreadBits(ix) | (SpreadBits(iy) << 1);
+}
+
+// values[i] pasa a ser values[order[i]]
+template<typename T>
+void BodyIndex::Permute(std::vector<T>& values, const std::vector<int>& order)
+{
+    std::vector<T> sorted(values.size());
+    for (size_t i = 0; i < order.size(); i++)
+        sorted[i] = values[order[i]];
+    values.swap(sorted);
+}
+
+void BodyIndex::SortMorton()
+{
+    int count = (int)bodies.size();
+    if (count < 2)
+        return;
+
+    b2AABB bounds;
+    bounds.lowerBound.Set(posX[0], posY[0]);
+    bounds.upperBound = bounds.lowerBound;
+    for (int i = 1; i < count; i++)
+    {
+        bounds.lowerBound = b2Min(bounds.lowerBound, b2Vec2(posX[i], posY[i]));
+        bounds.upperBound = b2Max(bounds.upperBound, b2Vec2(posX[i], posY[i]));
+    }
+
+    std::vector<std::pair<uint32, int>> keys(count);
+    for (int i = 0; i < count; i++)
+        keys[i] = std::make_pair(MortonCode(posX[i], posY[i], bounds), i);
+    std::sort(keys.begin(), keys.end());
+
+    std::vector<int> order(count);
+    for (int i = 0; i < count; i++)
+        order[i] = keys[i].second;
+
+    Permute(bodies, order);
+    Permute(tags, order);
+    Permute(posX, order);
+    Permute(posY, order);
+    Permute(angle, order);
+    Permute(velX, order);
+    Permute(velY, order);
+    Permute(awake, order);
+    for (int i = 0; i < count; i++)
+        bodies[i]->GetUserData().pointer = (uintptr_t)i + 1;
+}
+
+void BodyIndex::SortMorton(std::vector<b2Body*>& list)
+{
+    if (list.size() < 2)
+        return;
+
+    b2AABB bounds;
+    bounds.lowerBound = list[0]->GetPosition();
+    bounds.upperBound = bounds.lowerBound;
+    for (b2Body* body : list)
+    {
+        bounds.lowerBound = b2Min(bounds.lowerBound, body->GetPosition());
+        bounds.upperBound = b2Max(bounds.upperBound, body->GetPosition());
+    }
+
+    std::vector<std::pair<uint32, b2Body*>> keys(list.size());
+    for (size_t i = 0; i < list.size(); i++)
+    {
+        const b2Vec2& p = list[i]->GetPosition();
+        keys[i] = std::make_pair(MortonCode(p.x, p.y, bounds), list[i]);
+    }
+    std::sort(keys.begin(), keys.end());
+
+    for (size_t i = 0; i < list.size(); i++)
+        list[i] = keys[i].second;
+}
@@ -0,0 +1,75 @@
+//-----------------------------------------------------
+//ndice denso de bodies dinmicos. Guarda los bodies en
+//un arreglo contiguo y, en arreglos paralelos, una copia
+//de su posicin, ngulo, velocidad y estado (despierto y
+//habilitado). Sync la actualiza despus de cada Step con
+//una sola pasada por los bodies; el resto de las pasadas
+//del frame (lgica, culling, dibujo) recorren la copia
+//sin seguir la lista enlazada de b2World::GetBodyList.
+//Cada body registrado lleva en userData.pointer su lugar
+//en el ndice ms 1, as Remove no busca.
+//SortMorton reordena el ndice por la curva Z de las
+//posiciones, para que bodies cercanos en el espacio
+//queden cerca en memoria despus de muchas altas y bajas
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <vector>
+
+class BodyIndex
+{
+private:
+	std::vector<b2Body*> bodies;
+	std::vector<int> tags;			// dato del juego asociado a cada body
+
+	// Copia del estado de cada body (en metros y radianes)
+	std::vector<float> posX;
+	std::vector<float> posY;
+	std::vector<float> angle;
+	std::vector<float> velX;
+	std::vector<float> velY;
+	std::vector<uint8> awake;		// despierto y habilitado en el ltimo Sync
+
+	int awakeCount;
+
+	void Copy(int i);
+	template<typename T> static void Permute(std::vector<T>& values, const std::vector<int>& order);
+
+public:
+	BodyIndex(int capacity);
+
+	// Registra un body recin creado; tag es libre para el juego (p. ej. su lugar en otro arreglo)
+	void Add(b2Body* body, int tag = 0);
+
+	// Se llama antes de destruir el body. El ltimo body ocupa su lugar
+	void Remove(b2Body* body);
+
+	// Copia el estado de los bodies despus de Step. Los que siguen dormidos
+	// o deshabilitados desde el Sync anterior no se leen
+	void Sync();
+
+	int GetCount() const { return (int)bodies.size(); }
+	int GetAwakeCount() const { return awakeCount; }
+	b2Body* GetBody(int i) const { return bodies[i]; }
+	int GetTag(int i) const { return tags[i]; }
+
+	const float* GetPositionX() const { return bodies.empty() ? nullptr : &posX[0]; }
+	const float* GetPositionY() const { return bodies.empty() ? nullptr : &posY[0]; }
+	const float* GetAngle() const { return bodies.empty() ? nullptr : &angle[0]; }
+	const float* GetVelocityX() const { return bodies.empty() ? nullptr : &velX[0]; }
+	const float* GetVelocityY() const { return bodies.empty() ? nullptr : &velY[0]; }
+	const uint8* GetAwake() const { return bodies.empty() ? nullptr : &awake[0]; }
+
+	// Lugar del body en el ndice (-1 si no est registrado)
+	static int IndexOf(b2Body* body);
+
+	// Ordena el ndice por la curva Z de las posiciones del ltimo Sync
+	void SortMorton();
+
+	// Ordena una lista de bodies por la curva Z de sus posiciones
+	static void SortMorton(std::vector<b2Body*>& list);
+
+	// Cdigo de Morton de p dentro de bounds (16 bits por eje intercalados)
+	static uint32 MortonCode(float x, float y, const b2AABB& bounds);
+};
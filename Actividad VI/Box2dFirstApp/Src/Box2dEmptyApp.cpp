@@ -1,4 +1,6 @@
 #include "Game.h" // Incluye el archivo de encabezado de la clase Game
+#include "Benchmark.h" // Escenarios sin ventana para medir la simulacin
+#include "VecEnv.h" // Entorno vectorizado sin ventana
 #include <tchar.h> // Incluye la biblioteca de caracteres de Windows
 
 using namespace sf; // Espacio de nombres para la biblioteca SFML
@@ -6,6 +8,20 @@ using namespace sf; // Espacio de nombres para la biblioteca SFML
 // Funcin principal del programa
 int _tmain(int argc, _TCHAR* argv[])
 {
+    // Con --bench se corren los benchmarks sin abrir la ventana
+    if (argc > 1 && _tcscmp(argv[1], _T("--bench")) == 0)
+    {
+        Benchmark::RunAll();
+        return 0;
+    }
+
+    // Con --vecenv se mide el rendimiento del entorno vectorizado sin abrir la ventana
+    if (argc > 1 && _tcscmp(argv[1], _T("--vecenv")) == 0)
+    {
+        VecEnv::RunThroughput(argc > 2 ? _ttoi(argv[2]) : 256, 600);
+        return 0;
+    }
+
     // Crear el objeto de la clase Game
     Game* Juego;
     Juego = new Game(800, 600, "MAVII");
@@ -0,0 +1,253 @@
+#include "FatteningProbe.h"
+#include <algorithm>
+#include <iostream>
+#include <iomanip>
+
+void BroadphaseCounters::Reset()
+{
+    reinsertions = 0;
+    pairs = 0;
+    falsePairs = 0;
+    slowReinsertions = 0;
+    fastReinsertions = 0;
+}
+
+// Constructor: las copias se llenan en el primer Observe
+FatteningProbe::FatteningProbe(b2World* world, float timeStep, const FatteningPolicy& policy)
+{
+    this->world = world;
+    this->timeStep = timeStep;
+    this->policy = policy;
+    fastSpeed = 2.0f;
+    box2dCounters.Reset();
+    adaptiveCounters.Reset();
+    steps = 0;
+}
+
+FatteningPolicy FatteningProbe::DefaultPolicy()
+{
+    FatteningPolicy policy;
+    policy.minExtension = 0.01f;
+    policy.sizeFraction = 0.1f;
+    policy.maxExtension = 0.1f;
+    policy.lookaheadSteps = 8.0f;
+    policy.speedSmoothing = 0.25f;
+    return policy;
+}
+
+// El hijo va en los 16 bits bajos (las direcciones de fixtures no los usan todos)
+FatteningProbe::ProxyKey FatteningProbe::Key(const b2Fixture* fixture, int32 child)
+{
+    return ((ProxyKey)(uintptr_t)fixture << 16) ^ (ProxyKey)child;
+}
+
+// Margen segn el tamao del proxy y, en la direccin de la velocidad,
+// el desplazamiento de lookaheadSteps pasos
+b2AABB FatteningProbe::FatAABB(const b2AABB& tight, const b2Vec2& velocity, float timeStep, const FatteningPolicy& policy)
+{
+    b2Vec2 size = tight.upperBound - tight.lowerBound;
+    float extension = b2Clamp(policy.sizeFraction * b2Max(size.x, size.y), policy.minExtension, policy.maxExtension);
+    b2Vec2 r(extension, extension);
+
+    b2AABB fat;
+    fat.lowerBound = tight.lowerBound - r;
+    fat.upperBound = tight.upperBound + r;
+
+    b2Vec2 d = policy.lookaheadSteps * timeStep * velocity;
+    if (d.x < 0.0f)
+        fat.lowerBound.x += d.x;
+    else
+        fat.upperBound.x += d.x;
+    if (d.y < 0.0f)
+        fat.lowerBound.y += d.y;
+    else
+        fat.upperBound.y += d.y;
+    return fat;
+}
+
+void FatteningProbe::Observe()
+{
+    ObserveBox2D();
+    ObserveAdaptive();
+    steps++;
+}
+
+// Lo que hizo box2d en el ltimo Step
+void FatteningProbe::ObserveBox2D()
+{
+    for (auto& entry : box2dProxies)
+        entry.second.seen = false;
+
+    for (b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+    {
+        if (!body->IsEnabled())
+            continue; // Sin proxies
+        bool fast = body->GetLinearVelocity().Length() >= fastSpeed;
+
+        for (b2Fixture* f = body->GetFixtureList(); f; f = f->GetNext())
+        {
+            for (int32 child = 0; child < f->GetShape()->GetChildCount(); child++)
+            {
+                const b2AABB& fat = f->GetAABB(child);
+                auto found = box2dProxies.find(Key(f, child));
+                if (found == box2dProxies.end())
+                {
+                    BoxState state;
+                    state.fat = fat;
+                    state.seen = true;
+                    box2dProxies[Key(f, child)] = state;
+                    continue;
+                }
+
+                BoxState& state = found->second;
+                state.seen = true;
+                if (state.fat.lowerBound != fat.lowerBound || state.fat.upperBound != fat.upperBound)
+                {
+                    box2dCounters.reinsertions++;
+                    (fast ? box2dCounters.fastReinsertions : box2dCounters.slowReinsertions)++;
+                    state.fat = fat;
+                }
+            }
+        }
+    }
+
+    for (auto it = box2dProxies.begin(); it != box2dProxies.end(); )
+        it = it->second.seen ? std::next(it) : box2dProxies.erase(it);
+
+    // Par falso: los AABBs engordados se tocan pero los justos no
+    for (b2Contact* c = world->GetContactList(); c; c = c->GetNext())
+    {
+        box2dCounters.pairs++;
+        b2Fixture* a = c->GetFixtureA();
+        b2Fixture* b = c->GetFixtureB();
+        b2AABB tightA, tightB;
+        a->GetShape()->ComputeAABB(&tightA, a->GetBody()->GetTransform(), c->GetChildIndexA());
+        b->GetShape()->ComputeAABB(&tightB, b->GetBody()->GetTransform(), c->GetChildIndexB());
+        if (!b2TestOverlap(tightA, tightB))
+            box2dCounters.falsePairs++;
+    }
+}
+
+// La copia adaptiva: se reinserta si el AABB justo se sale del engordado o si
+// el engordado qued mucho ms grande de lo que hara falta ahora
+void FatteningProbe::ObserveAdaptive()
+{
+    for (auto& entry : adaptiveProxies)
+        entry.second.seen = false;
+
+    float slack = 4.0f * policy.maxExtension;
+    for (b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+    {
+        if (!body->IsEnabled())
+            continue;
+        const b2Transform& xf = body->GetTransform();
+        b2Vec2 v = body->GetLinearVelocity();
+
+        for (b2Fixture* f = body->GetFixtureList(); f; f = f->GetNext())
+        {
+            for (int32 child = 0; child < f->GetShape()->GetChildCount(); child++)
+            {
+                b2AABB tight;
+                f->GetShape()->ComputeAABB(&tight, xf, child);
+
+                auto found = adaptiveProxies.find(Key(f, child));
+                if (found == adaptiveProxies.end())
+                {
+                    Proxy proxy;
+                    proxy.fixture = f;
+                    proxy.child = child;
+                    proxy.tight = tight;
+                    proxy.velocity = v;
+                    proxy.fat = FatAABB(tight, v, timeStep, policy);
+                    proxy.seen = true;
+                    adaptiveProxies[Key(f, child)] = proxy;
+                    continue;
+                }
+
+                Proxy& proxy = found->second;
+                proxy.seen = true;
+                proxy.tight = tight;
+                proxy.velocity = (1.0f - policy.speedSmoothing) * proxy.velocity + policy.speedSmoothing * v;
+
+                b2AABB wanted = FatAABB(tight, proxy.velocity, timeStep, policy);
+                b2AABB huge;
+                huge.lowerBound = wanted.lowerBound - b2Vec2(slack, slack);
+                huge.upperBound = wanted.upperBound + b2Vec2(slack, slack);
+                if (!proxy.fat.Contains(tight) || !huge.Contains(proxy.fat))
+                {
+                    adaptiveCounters.reinsertions++;
+                    (proxy.velocity.Length() >= fastSpeed ? adaptiveCounters.fastReinsertions : adaptiveCounters.slowReinsertions)++;
+                    proxy.fat = wanted;
+                }
+            }
+        }
+    }
+
+    for (auto it = adaptiveProxies.begin(); it != adaptiveProxies.end(); )
+        it = it->second.seen ? std::next(it) : adaptiveProxies.erase(it);
+
+    CountAdaptivePairs();
+}
+
+// Mismo criterio que box2d para crear un contacto (sin joints, que este juego no usa)
+bool FatteningProbe::CanCollide(b2Fixture* a, b2Fixture* b)
+{
+    b2Body* bodyA = a->GetBody();
+    b2Body* bodyB = b->GetBody();
+    if (bodyA == bodyB)
+        return false;
+    if (bodyA->GetType() != b2_dynamicBody && bodyB->GetType() != b2_dynamicBody)
+        return false;
+    return filter.ShouldCollide(a, b);
+}
+
+// Pares de la copia adaptiva por barrido en x
+void FatteningProbe::CountAdaptivePairs()
+{
+    sweep.clear();
+    for (const auto& entry : adaptiveProxies)
+        sweep.push_back(&entry.second);
+    std::sort(sweep.begin(), sweep.end(), [](const Proxy* a, const Proxy* b)
+    {
+        return a->fat.lowerBound.x < b->fat.lowerBound.x;
+    });
+
+    for (size_t i = 0; i < sweep.size(); i++)
+    {
+        const Proxy* a = sweep[i];
+        for (size_t j = i + 1; j < sweep.size() && sweep[j]->fat.lowerBound.x <= a->fat.upperBound.x; j++)
+        {
+            const Proxy* b = sweep[j];
+            if (!b2TestOverlap(a->fat, b->fat) || !CanCollide(a->fixture, b->fixture))
+                continue;
+
+            adaptiveCounters.pairs++;
+            if (!b2TestOverlap(a->tight, b->tight))
+                adaptiveCounters.falsePairs++;
+        }
+    }
+}
+
+// Promedios por paso de las dos polticas
+void FatteningProbe::Print() const
+{
+    int n = steps > 0 ? steps : 1;
+    const BroadphaseCounters* rows[] = { &box2dCounters, &adaptiveCounters };
+    const char* names[] = { "box2d (fijo)", "adaptivo" };
+
+    std::cout << std::left << std::setw(14) << "engorde"
+        << std::right << std::setw(14) << "reinsert/paso"
+        << std::setw(10) << "lentos" << std::setw(10) << "rapidos"
+        << std::setw(12) << "pares/paso" << std::setw(12) << "falsos" << std::endl;
+    for (int i = 0; i < 2; i++)
+    {
+        const BroadphaseCounters& c = *rows[i];
+        std::cout << std::left << std::setw(14) << names[i]
+            << std::right << std::fixed << std::setprecision(2)
+            << std::setw(14) << (float)c.reinsertions / n
+            << std::setw(10) << (float)c.slowReinsertions / n
+            << std::setw(10) << (float)c.fastReinsertions / n
+            << std::setw(12) << (float)c.pairs / n
+            << std::setw(12) << (float)c.falsePairs / n << std::endl;
+    }
+}
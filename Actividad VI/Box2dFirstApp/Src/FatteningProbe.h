@@ -0,0 +1,106 @@
+//-----------------------------------------------------
+//Herramienta de medicin del broadphase, solo para
+//Benchmark::RunFattening: no cambia el engorde de
+//ningn proxy. Box2D engorda todos los proxies igual
+//(b2_aabbExtension y b2_aabbMultiplier en b2_common.h,
+//compilados dentro de la biblioteca), as que no se puede
+//cambiar por proxy. Observe, llamado despus de Step,
+//cuenta lo que hace box2d: proxies reinsertados (su AABB
+//engordado cambi) y pares falsos (contactos cuyos shapes
+//no se tocan). En paralelo mantiene una copia de los
+//proxies con un engorde adaptivo (segn tamao y velocidad
+//reciente de cada body) y cuenta lo mismo para ella, as
+//se ve cunto ahorrara esa poltica si se pudiera usar
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <unordered_map>
+#include <vector>
+
+// Parmetros del engorde adaptivo (en metros y pasos)
+struct FatteningPolicy
+{
+	float minExtension;		// margen mnimo para bodies quietos
+	float sizeFraction;		// margen proporcional al tamao del proxy
+	float maxExtension;		// tope del margen por tamao
+	float lookaheadSteps;	// pasos de desplazamiento que se adelantan en la direccin de la velocidad
+	float speedSmoothing;	// peso de la velocidad nueva en el promedio (0..1)
+};
+
+// Conteos de una poltica
+struct BroadphaseCounters
+{
+	int reinsertions;
+	int pairs;
+	int falsePairs;
+	int slowReinsertions;	// de bodies por debajo de la velocidad de corte
+	int fastReinsertions;
+
+	void Reset();
+};
+
+class FatteningProbe
+{
+private:
+	// Proxy de la copia adaptiva
+	struct Proxy
+	{
+		b2Fixture* fixture;
+		int32 child;
+		b2AABB tight;
+		b2AABB fat;
+		b2Vec2 velocity;	// promedio de la velocidad del body
+		bool seen;
+	};
+
+	// Fixture e hijo en una sola clave
+	typedef unsigned long long ProxyKey;
+
+	// Un proxy de box2d con su ltimo AABB engordado
+	struct BoxState
+	{
+		b2AABB fat;
+		bool seen;
+	};
+
+	b2World* world;
+	FatteningPolicy policy;
+	float timeStep;
+	float fastSpeed;		// velocidad de corte para separar lentos y rpidos (m/s)
+
+	std::unordered_map<ProxyKey, BoxState> box2dProxies;
+	std::unordered_map<ProxyKey, Proxy> adaptiveProxies;
+	std::vector<const Proxy*> sweep;
+	b2ContactFilter filter;
+
+	BroadphaseCounters box2dCounters;
+	BroadphaseCounters adaptiveCounters;
+	int steps;
+
+	static ProxyKey Key(const b2Fixture* fixture, int32 child);
+	void ObserveBox2D();
+	void ObserveAdaptive();
+	void CountAdaptivePairs();
+	bool CanCollide(b2Fixture* a, b2Fixture* b);
+
+	// AABB engordado de la copia adaptiva para ese AABB justo y esa velocidad (m/s)
+	static b2AABB FatAABB(const b2AABB& tight, const b2Vec2& velocity, float timeStep, const FatteningPolicy& policy);
+
+public:
+	FatteningProbe(b2World* world, float timeStep, const FatteningPolicy& policy);
+
+	// Poltica por defecto: margen chico para quietos y 8 pasos adelante para los rpidos
+	static FatteningPolicy DefaultPolicy();
+
+	// Se llama despus de cada Step
+	void Observe();
+
+	void SetFastSpeed(float metersPerSecond) { fastSpeed = metersPerSecond; }
+	const BroadphaseCounters& GetBox2DCounters() const { return box2dCounters; }
+	const BroadphaseCounters& GetAdaptiveCounters() const { return adaptiveCounters; }
+	int GetSteps() const { return steps; }
+
+	// Muestra los totales por paso de las dos polticas
+	void Print() const;
+};
@@ -7,10 +7,12 @@ Game::Game(int ancho, int alto, std::string titulo)
 {
     // Inicializacin de la ventana y configuracin de propiedades
     wnd = new RenderWindow(VideoMode(ancho, alto), titulo);
+    title = titulo;
     wnd->setVisible(true);
     fps = 60;
     wnd->setFramerateLimit(fps);
     frameTime = 1.0f / fps;
+    needsRedraw = true;
     SetZoom(); // Configuracin de la vista del juego
     InitPhysics(); // Inicializacin del motor de fsica
     // Inicializar el arreglo de proyectiles
@@ -18,6 +20,28 @@ Game::Game(int ancho, int alto, std::string titulo)
         projectiles[i] = nullptr;
         projectileActive[i] = false;
     }
+
+    // Muestreo del teclado a 1 kHz en su propio hilo
+    inputSampler = new InputSampler(1000);
+    inputSampler->Bind(Keyboard::Up, INPUT_UP);
+    inputSampler->Bind(Keyboard::Down, INPUT_DOWN);
+    inputSampler->Bind(Keyboard::P, INPUT_FIRE);
+    inputSampler->Bind(Keyboard::R, INPUT_RESET);
+    inputSampler->Bind(Keyboard::S, INPUT_SWARM);
+    inputSampler->Start();
+    hasNextInput = false;
+    actions = 0;
+    substeps = 4;
+    lastPhysicsTime = InputSampler::Now();
+
+    // Un hilo por ncleo contando al principal
+    jobs = new JobSystem(0);
+    projectileVertices.resize(MAX_PROJECTILES * PROJECTILE_VERTICES);
+    BuildProjectileVertices(projectiles, 0, MAX_PROJECTILES, &projectileVertices[0]);
+
+    // Shapes de todo el mundo, armados en renderParts tareas por frame
+    renderBatch = new RenderBatch(MAX_PROJECTILES * 36 + 1024);
+    renderParts = jobs->GetThreadCount() * 2;
 }
 
 // Bucle principal del juego
@@ -25,138 +49,422 @@ void Game::Loop()
 {
     while (wnd->isOpen())
     {
+        // Mundo dormido y sin teclas apretadas: no se simula ni se dibuja
+        if (IsIdle())
+        {
+            if (!needsRedraw)
+            {
+                WaitForEvent(); // Bloquea hasta el prximo evento de la ventana
+                continue;
+            }
+
+            // Solo se vuelve a presentar el ltimo estado (p. ej. despus de un resize)
+            wnd->clear(clearColor);
+            renderBatch->Draw(*wnd);
+            debugRender->DrawWorld(phyWorld);
+            DrawGame();
+            wnd->display();
+            needsRedraw = false;
+            continue;
+        }
+
+        DoEvents(); // Procesar eventos de la ventana (solo desde este hilo)
+        RunFrameGraph(); // Fsica, lgica y preparacin del dibujo en el JobSystem
+        DestroyExpiredProjectiles(); // Bajas que marc la lgica
         wnd->clear(clearColor); // Limpiar la ventana
-        DoEvents(); // Procesar eventos de entrada
-        CheckCollitions(); // Comprobar colisiones
-        UpdatePhysics(); // Actualizar la simulacin fsica
+        renderBatch->Draw(*wnd); // Shapes de todos los fixtures en una llamada
+        debugRender->DrawWorld(phyWorld); // Dibujar lo visible del mundo fsico para depuracin
         DrawGame(); // Dibujar el juego
+        UpdateTitle(); // Mostrar los golpes en el ttulo
         wnd->display(); // Mostrar la ventana
+        needsRedraw = false;
     }
+
+    inputSampler->Stop();
+    inputLatency.Print("latencia entrada-fisica");
+}
+
+// Arma y corre el grafo de tareas del frame:
+//   fsica -> lgica
+//         \-> preparacin del dibujo (un bloque de proyectiles por tarea)
+//         \-> registro de shapes -> armado de shapes (renderParts tareas)
+// La fsica es la nica que modifica el mundo; despus la lgica y los bloques
+// de dibujo solo leen posiciones, as corren en paralelo entre s. El hilo
+// principal ayuda en Wait y al volver ya puede destruir bodies y dibujar
+void Game::RunFrameGraph()
+{
+    viewBounds = debugRender->GetViewBounds(10.0f);
+
+    JobSystem::TaskHandle physics = jobs->CreateTask([this] { UpdatePhysics(); });
+    JobSystem::TaskHandle logic = jobs->CreateTask([this] { UpdateLogic(); });
+    jobs->AddDependency(logic, physics);
+
+    std::vector<JobSystem::TaskHandle> render;
+    for (int begin = 0; begin < MAX_PROJECTILES; begin += PROJECTILE_CHUNK)
+    {
+        int end = b2Min(begin + PROJECTILE_CHUNK, MAX_PROJECTILES);
+        JobSystem::TaskHandle task = jobs->CreateTask([this, begin, end]
+        {
+            BuildProjectileVertices(projectiles, begin, end, &projectileVertices[0], &viewBounds);
+        });
+        jobs->AddDependency(task, physics);
+        render.push_back(task);
+    }
+
+    JobSystem::TaskHandle shots = jobs->CreateTask([this] { BuildBallisticVertices(); });
+    jobs->AddDependency(shots, physics);
+    render.push_back(shots);
+
+    JobSystem::TaskHandle particles = jobs->CreateTask([this] { BuildSwarmVertices(); });
+    jobs->AddDependency(particles, physics);
+    render.push_back(particles);
+
+    JobSystem::TaskHandle gather = jobs->CreateTask([this] { renderBatch->Gather(phyWorld, viewBounds); });
+    jobs->AddDependency(gather, physics);
+    render.push_back(gather);
+    for (int part = 0; part < renderParts; part++)
+    {
+        JobSystem::TaskHandle task = jobs->CreateTask([this, part] { renderBatch->Build(part, renderParts); });
+        jobs->AddDependency(task, gather);
+        render.push_back(task);
+    }
+
+    jobs->Run(physics);
+    jobs->Run(logic);
+    for (const JobSystem::TaskHandle& task : render)
+        jobs->Run(task);
+    jobs->Wait();
+}
+
+// El juego est ocioso si ningn body est despierto, no hay teclas de
+// juego apretadas y no queda trabajo pendiente en el rbol del broadphase
+bool Game::IsIdle()
+{
+    if (actions != 0 || inputSampler->GetState() != 0 || hasNextInput)
+        return false;
+    if (treeMonitor->IsRebuilding() || teleports->GetPendingCount() > 0 || ballistic->GetCount() > 0)
+        return false;
+    if (swarm->GetMaxSpeed() > WorldUnits::ToMeters(1.0f))
+        return false; // El enjambre no duerme: se espera a que quede casi quieto
+
+    return Box2DHelper::IsWorldAsleep(phyWorld);
+}
+
+// Espera bloqueante de un evento (uso de CPU casi nulo mientras tanto). El
+// muestreo de teclado se pausa durante la espera: una tecla nueva llega tambin
+// como evento de la ventana y al volver el muestreo la ve apretada
+void Game::WaitForEvent()
+{
+    Event evt;
+    inputSampler->Pause();
+    bool received = wnd->waitEvent(evt);
+    inputSampler->Resume();
+    if (received)
+        ProcessEvent(evt);
 }
 
 // Actualizacin de la simulacin fsica
 void Game::UpdatePhysics()
 {
-    phyWorld->Step(frameTime, 8, 8); // Simular el mundo fsico
-    phyWorld->ClearForces(); // Limpiar las fuerzas aplicadas a los cuerpos
-    phyWorld->DebugDraw(); // Dibujar el mundo fsico para depuracin
-    for (int i = 0; i < MAX_PROJECTILES; i++) {
-        if (projectileActive[i]) {
-            b2Vec2 pos = projectiles[i]->GetPosition();
-            // Suponiendo que la ventana se extiende hasta x = 100 (o el ancho que hayas definido)
-            if (pos.x > 800.0f) {
-                phyWorld->DestroyBody(projectiles[i]);
-                projectiles[i] = nullptr;
-                projectileActive[i] = false;
-            }
+    float stepMs = StepWithInput(); // Simular el mundo fsico aplicando la entrada por subpaso
+    UpdateBallistic(); // Disparos en vuelo contra el mundo ya avanzado
+    UpdateSwarm(); // Partculas contra s mismas y contra los bodies
+
+    // El rbol se optimiza solo con el tiempo que sobra de la mitad del frame
+    float idleMs = frameTime * 1000.0f * 0.5f - stepMs;
+    treeMonitor->AfterStep(idleMs);
+    projectileIndex->Sync(); // Estado de los proyectiles para la lgica
+
+    // Cada 2 segundos, si el paso dej tiempo libre, se ordena el ndice por
+    // curva Z (las altas y bajas lo dejan en orden de creacin)
+    if (++sortCounter >= 120 && idleMs > 1.0f)
+    {
+        projectileIndex->SortMorton();
+        sortCounter = 0;
+    }
+}
+
+// Lgica del juego despus del paso: golpes y proyectiles que salieron de la escena.
+// Corre junto a la preparacin del dibujo, as que no modifica el mundo
+void Game::UpdateLogic()
+{
+    CheckCollitions(); // Comprobar colisiones
+
+    // Recorre la copia contigua de posiciones en lugar de cada b2Body
+    expiredProjectiles.clear();
+    const float* x = projectileIndex->GetPositionX();
+    float limit = WorldUnits::ToMeters(800.0f); // Suponiendo que la ventana se extiende hasta x = 800
+    for (int i = 0; i < projectileIndex->GetCount(); i++) {
+        if (x[i] > limit)
+            expiredProjectiles.push_back(projectileIndex->GetTag(i));
+    }
+}
+
+// Avanza los disparos sin body, quita los que salieron de la escena y convierte
+// en proyectiles con body a los que chocaron con algo. Corre en la tarea de fsica
+void Game::UpdateBallistic()
+{
+    ballistic->RemoveBeyond(800.0f); // Mismo lmite que los proyectiles con body
+    ballistic->Step(frameTime);
+
+    promoted.clear();
+    ballistic->Promote(2.0f, 1.0f, 0.5f, promoted);
+    for (b2Body* body : promoted)
+    {
+        int slot = -1;
+        for (int i = 0; i < MAX_PROJECTILES && slot < 0; i++)
+        {
+            if (!projectileActive[i])
+                slot = i;
         }
+        if (slot < 0)
+        {
+            phyWorld->DestroyBody(body); // Sin lugar: el disparo se pierde en el choque
+            continue;
+        }
+
+        projectiles[slot] = body;
+        projectileIndex->Add(body, slot);
+        projectileActive[slot] = true;
     }
 }
 
-// Dibujo de los elementos del juego
-void Game::DrawGame()
+// Mientras se aprieta la tecla del enjambre sale un chorro de partculas del
+// lanzador; despus se avanza el enjambre y se quitan las que salieron de la escena
+void Game::UpdateSwarm()
 {
-    // Dibujar las paredes
-    sf::RectangleShape leftWallShape(sf::Vector2f(10, alto)); // Alto de la ventana
-    leftWallShape.setFillColor(sf::Color::Blue);
-    leftWallShape.setPosition(100, 0); // X = 100 para que comience donde termina el suelo
-    wnd->draw(leftWallShape);
+    if (actions & INPUT_SWARM)
+    {
+        b2Vec2 controlPos = WorldUnits::ToUnits(controlBody->GetPosition());
+        for (int k = 0; k < 40; k++)
+        {
+            b2Vec2 position(controlPos.x + 12.0f + (k % 4) * 2.0f, controlPos.y - 4.0f + (k / 4) * 0.8f);
+            swarm->Add(position, b2Vec2(40.0f + (k % 5) * 4.0f, (float)(k % 7) * 2.0f - 6.0f));
+        }
+    }
 
-    // Dibujar el cuerpo de control (rectangulo)
-    sf::RectangleShape controlShape(sf::Vector2f(20, 10));
-    controlShape.setFillColor(sf::Color::Yellow);
-    controlShape.setPosition(controlBody->GetPosition().x - 10, controlBody->GetPosition().y - 5);
-    wnd->draw(controlShape);
+    swarm->Step(frameTime);
 
-    // Dibujar el suelo
-    sf::RectangleShape groundShape(sf::Vector2f(500, 5));
-    groundShape.setFillColor(sf::Color::Red);
-    groundShape.setPosition(0, 95);
-    wnd->draw(groundShape);
-    //Dibujar el techo
-    sf::RectangleShape upWallShape(sf::Vector2f(500, 5));
-    upWallShape.setFillColor(sf::Color::Red);
-    upWallShape.setPosition(0, 0);
-    wnd->draw(upWallShape);
+    b2AABB scene;
+    scene.lowerBound.Set(-100.0f, -100.0f);
+    scene.upperBound.Set(800.0f, 300.0f);
+    swarm->RemoveOutside(scene);
+}
 
+// Dos tringulos por partcula dentro de la vista
+void Game::BuildSwarmVertices()
+{
+    swarmVertices.clear();
+    const float* x = swarm->GetPositionX();
+    const float* y = swarm->GetPositionY();
+    float r = WorldUnits::ToUnits(swarm->GetRadius());
+    Color color(120, 200, 255);
+    for (int i = 0; i < swarm->GetCount(); i++)
+    {
+        if (x[i] < viewBounds.lowerBound.x || x[i] > viewBounds.upperBound.x
+            || y[i] < viewBounds.lowerBound.y || y[i] > viewBounds.upperBound.y)
+            continue;
 
-    // Dibujar los proyectiles activos
-    for (int i = 0; i < MAX_PROJECTILES; i++) {
-        if (projectileActive[i]) {
-            b2Vec2 pos = projectiles[i]->GetPosition();
-            float angle = projectiles[i]->GetAngle();
-            sf::CircleShape projShape(2);
-            projShape.setOrigin(2.0f, 2.0f); // Centrar
-            projShape.setPosition(pos.x, pos.y);
-            projShape.setRotation(angle * 180.0f / b2_pi);
-            projShape.setFillColor(sf::Color::Yellow);
-            wnd->draw(projShape);
+        b2Vec2 pos = WorldUnits::ToUnits(b2Vec2(x[i], y[i]));
+        Vector2f a(pos.x - r, pos.y - r), b(pos.x + r, pos.y - r);
+        Vector2f c(pos.x + r, pos.y + r), d(pos.x - r, pos.y + r);
+        swarmVertices.push_back(Vertex(a, color));
+        swarmVertices.push_back(Vertex(b, color));
+        swarmVertices.push_back(Vertex(c, color));
+        swarmVertices.push_back(Vertex(a, color));
+        swarmVertices.push_back(Vertex(c, color));
+        swarmVertices.push_back(Vertex(d, color));
+    }
+}
+
+// Tringulos de los disparos en vuelo (mismo crculo que los proyectiles con body)
+void Game::BuildBallisticVertices()
+{
+    const int segments = PROJECTILE_VERTICES / 3;
+    const float radius = 2.0f;
+    Vector2f ring[segments + 1];
+    for (int k = 0; k <= segments; k++)
+    {
+        float angle = 2.0f * b2_pi * k / segments;
+        ring[k] = Vector2f(radius * cosf(angle), radius * sinf(angle));
+    }
+
+    ballisticVertices.clear();
+    const float* x = ballistic->GetPositionX();
+    const float* y = ballistic->GetPositionY();
+    for (int i = 0; i < ballistic->GetCount(); i++)
+    {
+        if (x[i] < viewBounds.lowerBound.x || x[i] > viewBounds.upperBound.x
+            || y[i] < viewBounds.lowerBound.y || y[i] > viewBounds.upperBound.y)
+            continue;
+
+        b2Vec2 pos = WorldUnits::ToUnits(b2Vec2(x[i], y[i]));
+        Vector2f center(pos.x, pos.y);
+        for (int k = 0; k < segments; k++)
+        {
+            ballisticVertices.push_back(Vertex(center, Color::Yellow));
+            ballisticVertices.push_back(Vertex(center + ring[k], Color::Yellow));
+            ballisticVertices.push_back(Vertex(center + ring[k + 1], Color::Yellow));
         }
     }
 }
 
-// Procesamiento de eventos de entrada
-void Game::DoEvents()
+// Destruye los proyectiles que marc la lgica (con el grafo ya terminado)
+void Game::DestroyExpiredProjectiles()
 {
-    Event evt;
-    while (wnd->pollEvent(evt))
+    for (int i : expiredProjectiles) {
+        treeMonitor->Forget(projectiles[i]);
+        teleports->Cancel(projectiles[i]);
+        projectileIndex->Remove(projectiles[i]);
+        phyWorld->DestroyBody(projectiles[i]);
+        projectiles[i] = nullptr;
+        projectileActive[i] = false;
+        // Se oculta ya: sus vrtices se armaron antes de la baja
+        BuildProjectileVertices(projectiles, i, i + 1, &projectileVertices[0]);
+    }
+    expiredProjectiles.clear();
+}
+
+// Un crculo de 8 tringulos por proyectil. Los lugares vacos y los proyectiles
+// fuera de la vista quedan como tringulos degenerados transparentes para que
+// el arreglo no cambie de tamao
+void Game::BuildProjectileVertices(b2Body* const* bodies, int begin, int end, Vertex* out, const b2AABB* bounds)
+{
+    const int segments = PROJECTILE_VERTICES / 3;
+    const float radius = 2.0f;
+    Vector2f ring[segments + 1];
+    for (int k = 0; k <= segments; k++)
+    {
+        float angle = 2.0f * b2_pi * k / segments;
+        ring[k] = Vector2f(radius * cosf(angle), radius * sinf(angle));
+    }
+
+    for (int i = begin; i < end; i++)
     {
-        switch (evt.type)
+        Vertex* v = out + i * PROJECTILE_VERTICES;
+        bool hidden = bodies[i] == nullptr;
+        if (!hidden && bounds != nullptr)
         {
-        case Event::Closed:
-            wnd->close(); // Cerrar la ventana si se presiona el botn de cerrar
-            break;
-            
+            b2Vec2 p = bodies[i]->GetPosition();
+            hidden = p.x < bounds->lowerBound.x || p.x > bounds->upperBound.x
+                || p.y < bounds->lowerBound.y || p.y > bounds->upperBound.y;
+        }
+        if (hidden)
+        {
+            for (int k = 0; k < PROJECTILE_VERTICES; k++)
+                v[k] = Vertex(Vector2f(0.0f, 0.0f), Color::Transparent);
+            continue;
+        }
+
+        b2Vec2 pos = WorldUnits::ToUnits(bodies[i]->GetPosition());
+        Vector2f center(pos.x, pos.y);
+        for (int k = 0; k < segments; k++)
+        {
+            v[3 * k] = Vertex(center, Color::Yellow);
+            v[3 * k + 1] = Vertex(center + ring[k], Color::Yellow);
+            v[3 * k + 2] = Vertex(center + ring[k + 1], Color::Yellow);
         }
     }
+}
 
-    // Controlar el movimiento del cuerpo de control con el teclado
-    // Segun la numeracion usada, cuando mas cerca de cero mas 
-    // lento es el desplazamiento sobre ese eje
-    if (Keyboard::isKeyPressed(Keyboard::Down))
-        controlBody->SetLinearVelocity(b2Vec2(0.0f, 30.0f));
-    else if (Keyboard::isKeyPressed(Keyboard::Up))
-        controlBody->SetLinearVelocity(b2Vec2(0.0f, -30.0f));
-    else
-        controlBody->SetLinearVelocity(b2Vec2(0.0f, 0.0f));
-
-    if (Keyboard::isKeyPressed(Keyboard::P)) {
-        // Se busca el primer espacio libre en el arreglo de proyectiles
-        for (int i = 0; i < MAX_PROJECTILES; i++) {
-            if (!projectileActive[i]) {
-                // Posicin de disparo: desde el borde derecho del cuerpo de control.
-                b2Vec2 controlPos = controlBody->GetPosition();
-                // Suponiendo que el rectngulo de control mide 20 de ancho y est centrado,
-                // su borde derecho es controlPos.x + 10.
-                float spawnX = controlPos.x + 10.0f;
-                float spawnY = controlPos.y;
-                b2Body* proj = Box2DHelper::CreateCircularDynamicBody(phyWorld, 2, 2, 1.0f, 0.5f);
-                proj->SetTransform(b2Vec2(spawnX, spawnY), 0.0f);
-                // Se le asigna una velocidad para que se mueva hacia la derecha
-                proj->SetLinearVelocity(b2Vec2(90.0f, 0.0f));
-                projectiles[i] = proj;
-                projectileActive[i] = true;
-                break; 
-            }
+// Avanza un frame de simulacin aplicando cada evento de entrada en su subpaso.
+// Los eventos que llegaron desde el ltimo UpdatePhysics se reparten en los
+// subpasos de este frame segn su marca de tiempo; entre eventos se simula
+// de un solo Step, as solo se parte el frame cuando hay entrada nueva.
+// Devuelve el tiempo total de Step en ms
+float Game::StepWithInput()
+{
+    double now = InputSampler::Now();
+    double span = now - lastPhysicsTime;
+    if (span <= 0.0 || span > 2.0 * frameTime)
+        span = frameTime; // Primer frame o vuelta del modo ocioso
+    double spanStart = now - span;
+    lastPhysicsTime = now;
+
+    float substepTime = frameTime / substeps;
+    int simulated = 0;
+    bool fired = false;
+    float stepMs = 0.0f;
+    b2Timer stepTimer;
+
+    ApplyControl(fired);
+    while (hasNextInput || inputSampler->Pop(nextInput))
+    {
+        hasNextInput = true;
+        if (nextInput.time > now)
+            break; // Se muestre despus de empezar este frame: queda para el prximo
+
+        // Subpaso que corresponde al instante del evento dentro del frame
+        int substep = (int)((nextInput.time - spanStart) / span * substeps);
+        substep = b2Clamp(substep, simulated, substeps - 1);
+        if (substep > simulated)
+        {
+            teleports->Apply(); // Reubicaciones anotadas por ApplyControl
+            stepTimer.Reset();
+            phyWorld->Step((substep - simulated) * substepTime, 8, 3);
+            stepMs += stepTimer.GetMilliseconds();
+            phyWorld->ClearForces();
+            simulated = substep;
         }
+
+        actions = nextInput.actions;
+        hasNextInput = false;
+        inputLatency.Add((float)((InputSampler::Now() - nextInput.time) * 1000.0));
+        ApplyControl(fired);
     }
-    controlBody->SetAwake(true);
 
-    b2Vec2 pos = controlBody->GetPosition();
+    teleports->Apply();
+    stepTimer.Reset();
+    phyWorld->Step((substeps - simulated) * substepTime, 8, 3);
+    stepMs += stepTimer.GetMilliseconds();
+    phyWorld->ClearForces(); // Limpiar las fuerzas aplicadas a los cuerpos
+    return stepMs;
+}
+
+// Aplica las acciones vigentes al cuerpo de control. Dispara a lo sumo un
+// proyectil por frame, en el primer subpaso en que la tecla est apretada
+void Game::ApplyControl(bool& fired)
+{
+    ApplyAction(controlBody, ballistic, fired ? actions & ~INPUT_FIRE : actions);
+    if (actions & INPUT_FIRE)
+        fired = true;
+
+    // Un reinicio por pulsacin de la tecla
+    if ((actions & INPUT_RESET) && !resetHeld)
+        QueueReset();
+    resetHeld = (actions & INPUT_RESET) != 0;
+}
+
+// Disparo y movimiento del cuerpo de control (teclado o entorno vectorizado)
+void Game::ApplyAction(b2Body* controlBody, BallisticProjectiles* ballistic, uint32 actions)
+{
+    if (actions & INPUT_FIRE) {
+        // El disparo sale sin body desde el borde derecho del cuerpo de control
+        // (mismo lugar y velocidad que CreateProjectile); recibe un body al chocar
+        b2Vec2 controlPos = WorldUnits::ToUnits(controlBody->GetPosition());
+        ballistic->Fire(b2Vec2(controlPos.x + 10.0f, controlPos.y), b2Vec2(90.0f, 0.0f));
+    }
+
+    // Controlar el movimiento del cuerpo de control con el teclado
+    // Segun la numeracion usada, cuando mas cerca de cero mas 
+    // lento es el desplazamiento sobre ese eje.
+    // SetLinearVelocity despierta al cuerpo solo si la velocidad no es cero,
+    // as el mundo puede dormirse cuando no se aprieta ninguna tecla
+    b2Vec2 pos = WorldUnits::ToUnits(controlBody->GetPosition());
     float topLimit = 10.0f;  // Lmite superior (altura del techo)
     float bottomLimit = 90.0f; // Lmite inferior (altura del suelo)
 
-    if (Keyboard::isKeyPressed(Keyboard::Down))
+    if (actions & INPUT_DOWN)
     {
         if (pos.y < bottomLimit)  // Verificar si est dentro del lmite inferior
-            controlBody->SetLinearVelocity(b2Vec2(0.0f, 30.0f));
+            controlBody->SetLinearVelocity(WorldUnits::ToMeters(b2Vec2(0.0f, 30.0f)));
         else
             controlBody->SetLinearVelocity(b2Vec2(0.0f, 0.0f));  // Frenar en el lmite
     }
-    else if (Keyboard::isKeyPressed(Keyboard::Up))
+    else if (actions & INPUT_UP)
     {
         if (pos.y > topLimit)  // Verificar si est dentro del lmite superior
-            controlBody->SetLinearVelocity(b2Vec2(0.0f, -30.0f));
+            controlBody->SetLinearVelocity(WorldUnits::ToMeters(b2Vec2(0.0f, -30.0f)));
         else
             controlBody->SetLinearVelocity(b2Vec2(0.0f, 0.0f));  // Frenar en el lmite
     }
@@ -166,10 +474,98 @@ void Game::DoEvents()
     }
 }
 
-// Comprobacin de colisiones (a implementar ms adelante)
+// Reinicio de la oleada: el cuerpo de control vuelve a su lugar y los
+// proyectiles vivos reaparecen en columnas delante de l, disparados de nuevo.
+// Solo se anotan los destinos; se aplican todos juntos antes del prximo Step
+void Game::QueueReset()
+{
+    teleports->Teleport(controlBody, b2Vec2(0.0f, 50.0f), 0.0f, b2Vec2(0.0f, 0.0f));
+
+    const int rows = 20;
+    for (int i = 0; i < projectileIndex->GetCount(); i++)
+    {
+        b2Vec2 position(15.0f + (i / rows) * 5.0f, 12.0f + (i % rows) * 4.0f);
+        teleports->Teleport(projectileIndex->GetBody(i), position, 0.0f, b2Vec2(90.0f, 0.0f));
+    }
+}
+
+// Dibujo de los elementos del juego
+void Game::DrawGame()
+{
+    // Dibujar las paredes
+    sf::RectangleShape leftWallShape(sf::Vector2f(10, alto)); // Alto de la ventana
+    leftWallShape.setFillColor(sf::Color::Blue);
+    leftWallShape.setPosition(100, 0); // X = 100 para que comience donde termina el suelo
+    wnd->draw(leftWallShape);
+
+    // Dibujar el cuerpo de control (rectangulo)
+    sf::RectangleShape controlShape(sf::Vector2f(20, 10));
+    controlShape.setFillColor(sf::Color::Yellow);
+    b2Vec2 controlPos = WorldUnits::ToUnits(controlBody->GetPosition());
+    controlShape.setPosition(controlPos.x - 10, controlPos.y - 5);
+    wnd->draw(controlShape);
+
+    // Dibujar el suelo
+    sf::RectangleShape groundShape(sf::Vector2f(500, 5));
+    groundShape.setFillColor(sf::Color::Red);
+    groundShape.setPosition(0, 95);
+    wnd->draw(groundShape);
+    //Dibujar el techo
+    sf::RectangleShape upWallShape(sf::Vector2f(500, 5));
+    upWallShape.setFillColor(sf::Color::Red);
+    upWallShape.setPosition(0, 0);
+    wnd->draw(upWallShape);
+
+
+    // Dibujar los proyectiles: los vrtices los arm el grafo del frame, van en una sola llamada
+    wnd->draw(&projectileVertices[0], projectileVertices.size(), sf::Triangles);
+    if (!ballisticVertices.empty())
+        wnd->draw(&ballisticVertices[0], ballisticVertices.size(), sf::Triangles);
+    if (!swarmVertices.empty())
+        wnd->draw(&swarmVertices[0], swarmVertices.size(), sf::Triangles);
+}
+
+// Procesamiento de eventos de la ventana (el teclado lo muestrea InputSampler)
+void Game::DoEvents()
+{
+    Event evt;
+    while (wnd->pollEvent(evt))
+        ProcessEvent(evt);
+}
+
+// Eventos de la ventana (desde pollEvent o waitEvent)
+void Game::ProcessEvent(const Event& evt)
+{
+    switch (evt.type)
+    {
+    case Event::Closed:
+        wnd->close(); // Cerrar la ventana si se presiona el botn de cerrar
+        break;
+    case Event::Resized:
+    case Event::GainedFocus:
+        needsRedraw = true; // El contenido de la ventana se perdi
+        break;
+    }
+}
+
+// Comprobacin de colisiones: procesa en bloque los eventos del ltimo Step
 void Game::CheckCollitions()
 {
-    // Implementacin de la comprobacin de colisiones
+    // Vaciar la cola de contactos contando los golpes de los proyectiles
+    contactQueue->Drain(CollisionLayers::GetCategoryBits(LAYER_PROJECTILE), [this](const ContactEvent& evt)
+    {
+        if (evt.type == CONTACT_HIT)
+            impactCount++;
+    });
+}
+
+// Muestra los golpes en el ttulo; solo se cambia cuando hay golpes nuevos
+void Game::UpdateTitle()
+{
+    if (impactCount == shownImpactCount)
+        return;
+    shownImpactCount = impactCount;
+    wnd->setTitle(title + " - golpes: " + std::to_string(impactCount));
 }
 
 // Configuracin de la vista del juego
@@ -185,28 +581,79 @@ void Game::SetZoom()
 // Inicializacin del motor de fsica y los cuerpos del mundo fsico
 void Game::InitPhysics()
 {
-    // Inicializar el mundo fsico con la gravedad por defecto
-    phyWorld = new b2World(b2Vec2(0.0f, 0.1f));
+    // Inicializar el mundo fsico (la gravedad la define BuildScene)
+    phyWorld = new b2World(b2Vec2(0.0f, 0.0f));
 
     // Crear un renderer de debug para visualizar el mundo fsico
     debugRender = new SFMLRenderer(wnd);
-    debugRender->SetFlags(UINT_MAX);
+    // Los shapes los dibuja renderBatch; el debug draw queda para joints, AABBs, pares y centros
+    debugRender->SetFlags(UINT_MAX & ~b2Draw::e_shapeBit);
     phyWorld->SetDebugDraw(debugRender);
 
-    // Crear el suelo y las paredes estticas del mundo fsico
-    b2Body* groundBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 100, 10);
-    groundBody->SetTransform(b2Vec2(50.0f, 100.0f), 0.0f);
-    groundBody->GetFixtureList()->SetFriction(0.1f);  //menos friccin, ms rebote
+    // Instalar la cola de eventos de contacto (se vaca en CheckCollitions)
+    contactQueue = new ContactQueue(4096);
+    phyWorld->SetContactListener(contactQueue);
+    phyWorld->SetDestructionListener(contactQueue);
+    impactCount = 0;
+    shownImpactCount = 0;
+
+    // Crear la escena (la misma que usan los benchmarks)
+    controlBody = BuildScene(phyWorld);
+
+    // Medir el rbol cada 60 pasos y reconstruirlo si la calidad pasa de 2
+    treeMonitor = new TreeMonitor(phyWorld, 60, 2.0f);
+
+    // Copia contigua del estado de los proyectiles para las pasadas del frame
+    projectileIndex = new BodyIndex(MAX_PROJECTILES);
+    sortCounter = 0;
 
-    b2Body* upWallBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 100, 10);
-    upWallBody->SetTransform(b2Vec2(250.0f, 50.0f), 0.0f);
+    teleports = new TeleportBatch(MAX_PROJECTILES + 1);
 
-    b2Body* leftWallBody = Box2DHelper::CreateRectangularStaticBody(phyWorld, 10, 100);
-    leftWallBody->SetTransform(b2Vec2(0.0f, 50.0f), 0.0f);
+    // Disparos del tamao de los proyectiles, en su misma capa
+    ballistic = new BallisticProjectiles(phyWorld, 2.0f, LAYER_PROJECTILE, MAX_BALLISTIC);
+    ballisticVertices.reserve(MAX_BALLISTIC * PROJECTILE_VERTICES);
+
+    // Partculas de radio 1 en la capa dinmica: chocan con todo, tambin con los proyectiles
+    swarm = new ParticleSwarm(phyWorld, 1.0f, 1.0f, 0.3f, LAYER_DYNAMIC, MAX_SWARM);
+    swarmVertices.reserve(MAX_SWARM * 6);
+    resetHeld = false;
+}
+
+// Creacin de la gravedad, las paredes y el cuerpo de control en el mundo dado.
+// Devuelve el cuerpo de control
+b2Body* Game::BuildScene(b2World* world)
+{
+    // Gravedad por defecto de la escena
+    world->SetGravity(WorldUnits::ToMeters(b2Vec2(0.0f, 0.1f)));
+
+    // Crear el suelo y las paredes estticas del mundo fsico, ya en su lugar
+    // Los proyectiles no chocan entre s ni con el lanzador (ver presets de CollisionLayers)
+    b2Body* groundBody = Box2DHelper::CreateRectangularStaticBody(world, 100, 10, LAYER_STATIC, b2Vec2(50.0f, 100.0f));
+    groundBody->GetFixtureList()->SetFriction(0.1f);  //menos friccin, ms rebote
+
+    Box2DHelper::CreateRectangularStaticBody(world, 100, 10, LAYER_STATIC, b2Vec2(250.0f, 50.0f)); // techo
+    Box2DHelper::CreateRectangularStaticBody(world, 10, 100, LAYER_STATIC, b2Vec2(0.0f, 50.0f)); // pared izquierda
 
     // Crear el cuerpo de control (rectngulo) como kinemtico para que no se mueva por colisiones
-    controlBody = Box2DHelper::CreateRectangularKinematicBody(phyWorld, 20, 10);
-    controlBody->SetTransform(b2Vec2(0.0f, 50.0f), 0.0f);
+    b2Body* control = Box2DHelper::CreateRectangularKinematicBody(world, 20, 10, LAYER_PLAYER, b2Vec2(0.0f, 50.0f));
+
+    return control;
+}
+
+// Creacin de un proyectil en el borde derecho del cuerpo de control
+b2Body* Game::CreateProjectile(b2World* world, b2Body* control)
+{
+    // Posicin de disparo: desde el borde derecho del cuerpo de control.
+    b2Vec2 controlPos = WorldUnits::ToUnits(control->GetPosition());
+    // Suponiendo que el rectngulo de control mide 20 de ancho y est centrado,
+    // su borde derecho es controlPos.x + 10.
+    float spawnX = controlPos.x + 10.0f;
+    float spawnY = controlPos.y;
+    b2Body* proj = Box2DHelper::CreateCircularDynamicBody(world, 2, 2, 1.0f, 0.5f, LAYER_PROJECTILE, b2Vec2(spawnX, spawnY));
+    // Se le asigna una velocidad para que se mueva hacia la derecha
+    proj->SetLinearVelocity(WorldUnits::ToMeters(b2Vec2(90.0f, 0.0f)));
+
+    return proj;
 }
 
 
@@ -2,6 +2,15 @@
 #include <SFML/Graphics.hpp>
 #include <SFML/System.hpp>
 #include "SFMLRenderer.h"
+#include "ContactQueue.h"
+#include "TreeMonitor.h"
+#include "InputSampler.h"
+#include "JobSystem.h"
+#include "RenderBatch.h"
+#include "BodyIndex.h"
+#include "TeleportBatch.h"
+#include "BallisticProjectiles.h"
+#include "ParticleSwarm.h"
 #include <list>
 #include <vector>
 using namespace sf;
@@ -17,11 +26,57 @@ private:
 	// Objetos de box2d
 	b2World *phyWorld;
 	SFMLRenderer *debugRender;
+	ContactQueue *contactQueue;
+
+	// Monitor del rbol del broadphase (se degrada con el alta y baja de proyectiles)
+	TreeMonitor *treeMonitor;
+
+	// Proyectiles vivos en un arreglo denso (tag = lugar en projectiles)
+	BodyIndex *projectileIndex;
+	int sortCounter;		// frames desde el ltimo orden por curva Z
+
+	// Disparos en vuelo sin body; pasan a projectiles cuando chocan con algo
+	BallisticProjectiles *ballistic;
+	std::vector<Vertex> ballisticVertices;	// tringulos de los disparos en vuelo
+	std::vector<b2Body*> promoted;			// bodies creados por el ltimo Promote
+
+	// Enjambre de partculas chicas fuera del b2World (acoplado a sus bodies)
+	ParticleSwarm *swarm;
+	std::vector<Vertex> swarmVertices;		// dos tringulos por partcula visible
+
+	// Reubicaciones del reinicio, aplicadas juntas antes del prximo Step
+	TeleportBatch *teleports;
+	bool resetHeld;			// la tecla de reinicio ya estaba apretada
+
+	// Golpes registrados por la cola de contactos, se muestran en el ttulo
+	int impactCount;
+	int shownImpactCount;
+	std::string title;
 
 	//tiempo de frame
 	float frameTime;
 	int fps;
 
+	// Hay que volver a presentar el frame aunque el juego est ocioso
+	bool needsRedraw;
+
+	// Entrada muestreada en otro hilo y aplicada por subpaso
+	InputSampler *inputSampler;
+	LatencyHistogram inputLatency;
+	InputEvent nextInput;		// evento sacado de la cola que todava no toca aplicar
+	bool hasNextInput;
+	uint32 actions;				// acciones vigentes en la simulacin
+	double lastPhysicsTime;		// instante (InputSampler::Now) del ltimo UpdatePhysics
+	int substeps;				// subpasos por frame en los que puede caer un evento
+
+	// Trabajo del frame repartido en tareas: fsica, lgica y preparacin del dibujo
+	JobSystem *jobs;
+	std::vector<Vertex> projectileVertices;	// tringulos de todos los proyectiles, se dibujan de una vez
+	std::vector<int> expiredProjectiles;	// proyectiles que la lgica marc para destruir
+	RenderBatch *renderBatch;				// shapes de todos los fixtures, armados en paralelo
+	int renderParts;						// tareas en las que se reparte renderBatch
+	b2AABB viewBounds;						// lo que se ve ms un margen, en metros (lo fija el hilo principal)
+
 	// Cuerpo de box2d
 	b2Body* controlBody;
 
@@ -34,14 +89,40 @@ public:
 	void CheckCollitions();
 	~Game(void);
 	void InitPhysics();
+
+	// Escena compartida con los benchmarks (no depende de la ventana)
+	static b2Body* BuildScene(b2World* world);
+	static b2Body* CreateProjectile(b2World* world, b2Body* control);
 	#define MAX_PROJECTILES 500  // Mximo nmero de proyectiles permitidos
+	#define PROJECTILE_VERTICES 24  // 8 tringulos por proyectil
+	#define PROJECTILE_CHUNK 64  // Proyectiles por tarea de preparacin del dibujo
+	#define MAX_BALLISTIC 4096  // Mximo de disparos en vuelo sin body
+	#define MAX_SWARM 20000  // Mximo de partculas del enjambre
+	// Tringulos de bodies[begin, end) en out (PROJECTILE_VERTICES por body, nullptr = oculto).
+	// Con bounds tambin quedan ocultos los que estn fuera de ese rectngulo
+	static void BuildProjectileVertices(b2Body* const* bodies, int begin, int end, Vertex* out, const b2AABB* bounds = nullptr);
 	b2Body* projectiles[MAX_PROJECTILES];
 	bool projectileActive[MAX_PROJECTILES];
 	// Main game loop
 	void Loop();
 	void DrawGame();
 	void UpdatePhysics();
+	void UpdateLogic();
+	void RunFrameGraph();
+	void DestroyExpiredProjectiles();
+	void UpdateBallistic();
+	void BuildBallisticVertices();
+	void UpdateSwarm();
+	void BuildSwarmVertices();
 	void DoEvents();
+	float StepWithInput();
+	void ApplyControl(bool& fired);
+	static void ApplyAction(b2Body* controlBody, BallisticProjectiles* ballistic, uint32 actions);
+	void QueueReset();
+	void ProcessEvent(const Event& evt);
+	bool IsIdle();
+	void WaitForEvent();
 	void SetZoom();
+	void UpdateTitle();
 };
 
@@ -0,0 +1,158 @@
+#include "InputSampler.h"
+#include <SFML/System.hpp>
+#include <chrono>
+#include <iostream>
+
+// Constructor del histograma vaco
+LatencyHistogram::LatencyHistogram(void)
+{
+    for (int i = 0; i < BucketCount; i++)
+        buckets[i] = 0;
+    count = 0;
+    totalMs = 0.0;
+    maxMs = 0.0f;
+}
+
+// Suma una muestra en el balde de su milisegundo
+void LatencyHistogram::Add(float ms)
+{
+    int bucket = (int)ms;
+    if (bucket < 0)
+        bucket = 0;
+    if (bucket >= BucketCount)
+        bucket = BucketCount - 1;
+
+    buckets[bucket]++;
+    count++;
+    totalMs += ms;
+    maxMs = b2Max(maxMs, ms);
+}
+
+// Muestra el histograma por consola con una barra por balde
+void LatencyHistogram::Print(const char* title) const
+{
+    std::cout << title << ": " << count << " muestras";
+    if (count == 0)
+    {
+        std::cout << std::endl;
+        return;
+    }
+    std::cout << ", media " << totalMs / count << " ms, max " << maxMs << " ms" << std::endl;
+
+    for (int i = 0; i < BucketCount; i++)
+    {
+        if (buckets[i] == 0)
+            continue;
+
+        std::cout << (i < 10 ? " " : "") << i << (i == BucketCount - 1 ? "+ ms " : "  ms ");
+        int bar = buckets[i] * 50 / count;
+        for (int j = 0; j < bar; j++)
+            std::cout << '#';
+        std::cout << " " << buckets[i] << std::endl;
+    }
+}
+
+// Constructor: el hilo arranca con Start
+InputSampler::InputSampler(int frequency)
+{
+    periodUs = 1000000 / (frequency > 0 ? frequency : 1000);
+    running = false;
+    paused = false;
+    state = 0;
+    dropped = 0;
+}
+
+// Destructor: detiene el hilo si sigue corriendo
+InputSampler::~InputSampler(void)
+{
+    Stop();
+}
+
+void InputSampler::Bind(sf::Keyboard::Key key, uint32 action)
+{
+    Binding binding;
+    binding.key = key;
+    binding.action = action;
+    bindings.push_back(binding);
+}
+
+void InputSampler::Start()
+{
+    if (running)
+        return;
+    running = true;
+    thread = std::thread(&InputSampler::Run, this);
+}
+
+void InputSampler::Stop()
+{
+    if (!running)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(pauseMutex);
+        running = false;
+    }
+    resumed.notify_one();
+    thread.join();
+}
+
+void InputSampler::Pause()
+{
+    std::lock_guard<std::mutex> lock(pauseMutex);
+    paused = true;
+}
+
+void InputSampler::Resume()
+{
+    {
+        std::lock_guard<std::mutex> lock(pauseMutex);
+        paused = false;
+    }
+    resumed.notify_one();
+}
+
+// Acciones con al menos una tecla apretada
+uint32 InputSampler::Sample() const
+{
+    uint32 actions = 0;
+    for (const Binding& binding : bindings)
+    {
+        if (sf::Keyboard::isKeyPressed(binding.key))
+            actions |= binding.action;
+    }
+    return actions;
+}
+
+// Bucle del hilo: muestrea y encola solo los cambios
+void InputSampler::Run()
+{
+    while (running)
+    {
+        uint32 actions = Sample();
+        if (actions != state)
+        {
+            InputEvent evt;
+            evt.actions = actions;
+            evt.time = Now();
+            if (queue.Push(evt))
+                state = actions;
+            else
+                dropped++; // Cola llena: se reintenta en el prximo muestreo
+        }
+
+        // sf::sleep sube la resolucin del timer del sistema en Windows
+        sf::sleep(sf::microseconds(periodUs));
+
+        if (paused)
+        {
+            std::unique_lock<std::mutex> lock(pauseMutex);
+            resumed.wait(lock, [this] { return !paused || !running; });
+        }
+    }
+}
+
+double InputSampler::Now()
+{
+    using namespace std::chrono;
+    return duration_cast<duration<double>>(steady_clock::now().time_since_epoch()).count();
+}
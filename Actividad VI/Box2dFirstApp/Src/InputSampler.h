@@ -0,0 +1,104 @@
+//-----------------------------------------------------
+//Muestreo de teclado en un hilo propio. Lee las teclas
+//asignadas a cada accin a alta frecuencia (1 kHz por
+//defecto) y, cada vez que cambia el conjunto de acciones
+//apretadas, encola un evento con la marca de tiempo del
+//muestreo en una SpscQueue. El juego vaca la cola antes
+//de simular y aplica cada evento en el subpaso que le
+//corresponde, en lugar de leer el teclado una vez por frame.
+//Mientras el juego espera eventos de la ventana sin
+//simular, Pause deja el hilo bloqueado en una variable de
+//condicin hasta Resume
+//-----------------------------------------------------
+
+#pragma once
+#include <SFML/Window.hpp>
+#include <Box2D/Box2D.h>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "SpscQueue.h"
+
+// Acciones de juego (un bit por accin)
+enum InputAction
+{
+	INPUT_UP = 1 << 0,
+	INPUT_DOWN = 1 << 1,
+	INPUT_FIRE = 1 << 2,
+	INPUT_RESET = 1 << 3,
+	INPUT_SWARM = 1 << 4
+};
+
+// Cambio del conjunto de acciones apretadas
+struct InputEvent
+{
+	uint32 actions;		// acciones apretadas desde este instante
+	double time;		// segundos (InputSampler::Now) del muestreo que detect el cambio
+};
+
+// Histograma de latencias de a 1 ms
+class LatencyHistogram
+{
+private:
+	static const int BucketCount = 32;	// el ltimo acumula todo lo que pasa de 31 ms
+	int buckets[BucketCount];
+	int count;
+	double totalMs;
+	float maxMs;
+
+public:
+	LatencyHistogram(void);
+
+	void Add(float ms);
+	void Print(const char* title) const;
+};
+
+class InputSampler
+{
+private:
+	// Tecla asignada a una accin
+	struct Binding
+	{
+		sf::Keyboard::Key key;
+		uint32 action;
+	};
+
+	std::vector<Binding> bindings;
+	SpscQueue<InputEvent, 256> queue;
+	std::thread thread;
+	std::atomic<bool> running;
+	std::atomic<bool> paused;
+	std::mutex pauseMutex;
+	std::condition_variable resumed;
+	std::atomic<uint32> state;
+	std::atomic<int> dropped;
+	int periodUs;
+
+	uint32 Sample() const;
+	void Run();
+
+public:
+	InputSampler(int frequency = 1000);
+	~InputSampler(void);
+
+	// Las asignaciones se hacen antes de Start
+	void Bind(sf::Keyboard::Key key, uint32 action);
+	void Start();
+	void Stop();
+
+	// Detiene el muestreo sin terminar el hilo (no consume CPU hasta Resume)
+	void Pause();
+	void Resume();
+
+	// Consumidor: saca el prximo cambio de acciones
+	bool Pop(InputEvent& evt) { return queue.Pop(evt); }
+
+	// ltimo estado muestreado (sin pasar por la cola)
+	uint32 GetState() const { return state; }
+	int GetDropped() const { return dropped; }
+
+	// Reloj montono en segundos, el mismo para el hilo de muestreo y el juego
+	static double Now();
+};
@@ -0,0 +1,190 @@
+#include "JobSystem.h"
+#include <chrono>
+
+// Pool y cola del hilo actual (el hilo que llama a Wait usa la cola 0)
+static thread_local JobSystem* currentSystem = nullptr;
+static thread_local int currentQueue = 0;
+
+// Constructor: crea una cola por hilo; la 0 es la del hilo que llama a Wait
+JobSystem::JobSystem(int threadCount)
+{
+    if (threadCount <= 0)
+        threadCount = (int)std::thread::hardware_concurrency();
+    if (threadCount <= 0)
+        threadCount = 1;
+    threadCount--; // El hilo que llama a Wait tambin trabaja
+
+    queued = 0;
+    pending = 0;
+    nextQueue = 0;
+    running = true;
+
+    for (int i = 0; i <= threadCount; i++)
+        queues.push_back(std::unique_ptr<WorkerQueue>(new WorkerQueue()));
+    for (int i = 1; i <= threadCount; i++)
+        threads.push_back(std::thread(&JobSystem::WorkerLoop, this, i));
+}
+
+// Destructor: despierta a los hilos y espera a que terminen
+JobSystem::~JobSystem(void)
+{
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        running = false;
+    }
+    wakeUp.notify_all();
+    for (std::thread& t : threads)
+        t.join();
+}
+
+// Reparte los trabajos entre las colas en orden circular
+void JobSystem::Submit(const Job& job)
+{
+    pending++;
+    size_t index = currentSystem == this ? currentQueue : nextQueue++ % queues.size();
+    WorkerQueue& queue = *queues[index];
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(job);
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queued++;
+    }
+    wakeUp.notify_one();
+}
+
+// Saca el ltimo trabajo de la cola propia (el ms reciente, con datos an en cach)
+bool JobSystem::TryPop(int index, Job& job)
+{
+    WorkerQueue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty())
+        return false;
+
+    job = std::move(queue.jobs.back());
+    queue.jobs.pop_back();
+    queued--;
+    return true;
+}
+
+// Roba el primer trabajo de la cola de otro hilo
+bool JobSystem::TrySteal(int thief, Job& job)
+{
+    int count = (int)queues.size();
+    for (int i = 1; i < count; i++)
+    {
+        WorkerQueue& queue = *queues[(thief + i) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.jobs.empty())
+            continue;
+
+        job = std::move(queue.jobs.front());
+        queue.jobs.pop_front();
+        queued--;
+        return true;
+    }
+    return false;
+}
+
+bool JobSystem::TryGetJob(int index, Job& job)
+{
+    return TryPop(index, job) || TrySteal(index, job);
+}
+
+// Ejecuta un trabajo y avisa si era el ltimo pendiente
+void JobSystem::Execute(Job& job)
+{
+    job();
+    job = nullptr;
+    if (--pending == 0)
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        allDone.notify_all();
+    }
+}
+
+// Bucle de cada hilo: trabaja mientras haya trabajos y duerme si no hay
+void JobSystem::WorkerLoop(int index)
+{
+    currentSystem = this;
+    currentQueue = index;
+    Job job;
+    while (running)
+    {
+        if (TryGetJob(index, job))
+        {
+            Execute(job);
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        wakeUp.wait(lock, [this] { return queued > 0 || !running; });
+    }
+}
+
+// El hilo que espera tambin ejecuta trabajos hasta que no quede ninguno
+void JobSystem::Wait()
+{
+    Job job;
+    while (pending > 0)
+    {
+        if (TryGetJob(0, job))
+        {
+            Execute(job);
+            continue;
+        }
+
+        // Quedan trabajos en ejecucin en otros hilos
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        allDone.wait_for(lock, std::chrono::milliseconds(1), [this] { return pending == 0; });
+    }
+}
+
+// Tarea sin dependencias todava; no se encola hasta Run
+JobSystem::TaskHandle JobSystem::CreateTask(const Job& job)
+{
+    TaskHandle task = std::make_shared<Task>();
+    task->job = job;
+    task->unfinished = 1;
+    return task;
+}
+
+// task espera a dependency. Solo antes de llamar a Run sobre cualquiera de las dos
+void JobSystem::AddDependency(const TaskHandle& task, const TaskHandle& dependency)
+{
+    task->unfinished++;
+    dependency->successors.push_back(task);
+}
+
+void JobSystem::Run(const TaskHandle& task)
+{
+    Release(task);
+}
+
+// Descuenta una dependencia; la ltima encola la tarea, que al terminar libera a sus sucesoras
+void JobSystem::Release(const TaskHandle& task)
+{
+    if (--task->unfinished > 0)
+        return;
+
+    Submit([this, task]
+    {
+        task->job();
+        for (const TaskHandle& successor : task->successors)
+            Release(successor);
+    });
+}
+
+// Un trabajo por bloque; los bloques chicos reparten mejor la carga
+void JobSystem::ParallelFor(int count, int grain, const std::function<void(int, int)>& body)
+{
+    if (grain < 1)
+        grain = 1;
+    for (int begin = 0; begin < count; begin += grain)
+    {
+        int end = begin + grain < count ? begin + grain : count;
+        Submit([&body, begin, end] { body(begin, end); });
+    }
+    Wait();
+}
@@ -0,0 +1,89 @@
+//-----------------------------------------------------
+//Pool de hilos con robo de trabajo. Cada hilo tiene su
+//propia cola: saca trabajos del final de la suya y,
+//cuando se queda sin trabajo, roba del principio de la
+//cola de otro hilo. As los trabajos largos no dejan
+//hilos ociosos aunque el reparto inicial sea desparejo.
+//El hilo que llama a Wait tambin ejecuta trabajos.
+//Las tareas (Task) agregan contadores de dependencias
+//para armar grafos: una tarea se encola recin cuando
+//terminan todas las tareas de las que depende
+//-----------------------------------------------------
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class JobSystem
+{
+public:
+	typedef std::function<void()> Job;
+
+	// Nodo de un grafo de tareas
+	struct Task
+	{
+		Job job;
+		std::atomic<int> unfinished;	// dependencias sin terminar, ms 1 hasta que se llama a Run
+		std::vector<std::shared_ptr<Task>> successors;
+	};
+	typedef std::shared_ptr<Task> TaskHandle;
+
+private:
+	// Cola de un hilo (protegida por su propio mutex)
+	struct WorkerQueue
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs;
+	};
+
+	std::vector<std::unique_ptr<WorkerQueue>> queues;
+	std::vector<std::thread> threads;
+
+	// Trabajos encolados y trabajos sin terminar (encolados + en ejecucin)
+	std::atomic<int> queued;
+	std::atomic<int> pending;
+	std::atomic<unsigned> nextQueue;
+	std::atomic<bool> running;
+
+	// Para dormir los hilos cuando no hay trabajo
+	std::mutex sleepMutex;
+	std::condition_variable wakeUp;
+	std::condition_variable allDone;
+
+	bool TryPop(int index, Job& job);
+	bool TrySteal(int thief, Job& job);
+	bool TryGetJob(int index, Job& job);
+	void Execute(Job& job);
+	void WorkerLoop(int index);
+	void Release(const TaskHandle& task);
+
+public:
+	// threadCount hilos en total contando al que llama a Wait (1 = todo en ese hilo).
+	// threadCount <= 0 usa un hilo por ncleo
+	JobSystem(int threadCount = 0);
+	~JobSystem(void);
+
+	// Encola un trabajo (desde un hilo del pool va a la cola de ese hilo)
+	void Submit(const Job& job);
+
+	// Grafo de tareas: se crean las tareas, se agregan las dependencias y
+	// despus se llama a Run para cada una. Wait espera a todo el grafo
+	TaskHandle CreateTask(const Job& job);
+	void AddDependency(const TaskHandle& task, const TaskHandle& dependency);
+	void Run(const TaskHandle& task);
+
+	// Espera a que terminen todos los trabajos, ejecutando trabajos mientras tanto
+	void Wait();
+
+	// Parte [0, count) en bloques de grain elementos, ejecuta body(begin, end) en paralelo y espera
+	void ParallelFor(int count, int grain, const std::function<void(int, int)>& body);
+
+	// Hilos que ejecutan trabajos, contando al que llama a Wait
+	int GetThreadCount() const { return (int)threads.size() + 1; }
+};
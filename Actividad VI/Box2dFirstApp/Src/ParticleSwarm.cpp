@@ -0,0 +1,394 @@
+#include "ParticleSwarm.h"
+#include "WorldUnits.h"
+#include <cmath>
+
+// Mximo de celdas de la grilla; si el enjambre se extiende ms, las celdas crecen
+#define SWARM_MAX_CELLS (1 << 20)
+
+ParticleSwarm::ParticleSwarm(b2World* world, float radius, float density, float restitution, CollisionLayer layer, int capacity)
+{
+    this->world = world;
+    this->restitution = restitution;
+    this->capacity = capacity;
+    circle.m_p.SetZero();
+    circle.m_radius = WorldUnits::ToMeters(radius);
+    mass = density * b2_pi * circle.m_radius * circle.m_radius;
+    filter = CollisionLayers::GetFilter(layer);
+
+    gridOrigin.SetZero();
+    cellSize = 2.0f * circle.m_radius;
+    cellsX = 0;
+    cellsY = 0;
+    bounds.lowerBound.SetZero();
+    bounds.upperBound.SetZero();
+    maxSpeed = 0.0f;
+
+    posX.reserve(capacity);
+    posY.reserve(capacity);
+    velX.reserve(capacity);
+    velY.reserve(capacity);
+}
+
+bool ParticleSwarm::Add(b2Vec2 position, b2Vec2 velocity)
+{
+    if ((int)posX.size() >= capacity)
+        return false;
+
+    b2Vec2 p = WorldUnits::ToMeters(position);
+    b2Vec2 v = WorldUnits::ToMeters(velocity);
+    posX.push_back(p.x);
+    posY.push_back(p.y);
+    velX.push_back(v.x);
+    velY.push_back(v.y);
+    return true;
+}
+
+void ParticleSwarm::Step(float dt, int iterations)
+{
+    if (posX.empty())
+    {
+        maxSpeed = 0.0f;
+        return;
+    }
+
+    Integrate(dt);
+    BuildGrid();
+    FindPairs();
+    for (int it = 0; it < iterations; it++)
+        SolvePairs();
+
+    // Fixtures del mundo cerca del enjambre, una consulta para todo el paso
+    colliders.clear();
+    ColliderQuery query;
+    query.owner = this;
+    b2Vec2 r(circle.m_radius, circle.m_radius);
+    b2AABB area;
+    area.lowerBound = bounds.lowerBound - r;
+    area.upperBound = bounds.upperBound + r;
+    world->QueryAABB(&query, area);
+
+    for (b2Fixture* fixture : colliders)
+    {
+        for (int32 child = 0; child < fixture->GetShape()->GetChildCount(); child++)
+            CollideFixture(fixture, child);
+    }
+}
+
+// Euler semi-implcito; de paso calcula el AABB de los centros y la rapidez mxima.
+// Sin saltos ni llamadas en el cuerpo para que el compilador lo vectorice
+void ParticleSwarm::Integrate(float dt)
+{
+    int count = (int)posX.size();
+    b2Vec2 g = world->GetGravity();
+    float* px = &posX[0];
+    float* py = &posY[0];
+    float* vx = &velX[0];
+    float* vy = &velY[0];
+
+    float minX = px[0], minY = py[0], maxX = px[0], maxY = py[0];
+    float maxSpeed2 = 0.0f;
+    for (int i = 0; i < count; i++)
+    {
+        vx[i] += g.x * dt;
+        vy[i] += g.y * dt;
+        px[i] += vx[i] * dt;
+        py[i] += vy[i] * dt;
+        minX = b2Min(minX, px[i]);
+        minY = b2Min(minY, py[i]);
+        maxX = b2Max(maxX, px[i]);
+        maxY = b2Max(maxY, py[i]);
+        maxSpeed2 = b2Max(maxSpeed2, vx[i] * vx[i] + vy[i] * vy[i]);
+    }
+
+    bounds.lowerBound.Set(minX, minY);
+    bounds.upperBound.Set(maxX, maxY);
+    maxSpeed = sqrtf(maxSpeed2);
+}
+
+int ParticleSwarm::CellX(float x) const
+{
+    return b2Clamp((int)((x - gridOrigin.x) / cellSize), 0, cellsX - 1);
+}
+
+int ParticleSwarm::CellY(float y) const
+{
+    return b2Clamp((int)((y - gridOrigin.y) / cellSize), 0, cellsY - 1);
+}
+
+// Counting sort por celda: las partculas de una celda quedan contiguas
+void ParticleSwarm::BuildGrid()
+{
+    int count = (int)posX.size();
+    b2Vec2 extent = bounds.upperBound - bounds.lowerBound;
+    cellSize = 2.0f * circle.m_radius;
+    float cells = (extent.x / cellSize + 1.0f) * (extent.y / cellSize + 1.0f);
+    if (cells > SWARM_MAX_CELLS)
+        cellSize *= sqrtf(cells / SWARM_MAX_CELLS);
+
+    gridOrigin = bounds.lowerBound;
+    cellsX = (int)(extent.x / cellSize) + 1;
+    cellsY = (int)(extent.y / cellSize) + 1;
+
+    cellOf.resize(count);
+    cellStart.assign(cellsX * cellsY + 1, 0);
+    for (int i = 0; i < count; i++)
+    {
+        int cell = CellY(posY[i]) * cellsX + CellX(posX[i]);
+        cellOf[i] = cell;
+        cellStart[cell + 1]++;
+    }
+    for (int c = 0; c < cellsX * cellsY; c++)
+        cellStart[c + 1] += cellStart[c];
+
+    order.resize(count);
+    std::vector<int> next(cellStart.begin(), cellStart.end() - 1);
+    for (int i = 0; i < count; i++)
+        order[i] = next[cellOf[i]]++;
+
+    Reorder(posX);
+    Reorder(posY);
+    Reorder(velX);
+    Reorder(velY);
+    std::vector<int> sortedCells(count);
+    for (int i = 0; i < count; i++)
+        sortedCells[order[i]] = cellOf[i];
+    cellOf.swap(sortedCells);
+}
+
+// values[order[i]] pasa a ser values[i]
+void ParticleSwarm::Reorder(std::vector<float>& values)
+{
+    scratch.resize(values.size());
+    for (size_t i = 0; i < values.size(); i++)
+        scratch[order[i]] = values[i];
+    values.swap(scratch);
+}
+
+// Cada partcula se compara con las siguientes de su celda y con las de 4
+// celdas vecinas (derecha y la fila de abajo), as cada par aparece una vez
+void ParticleSwarm::FindPairs()
+{
+    pairA.clear();
+    pairB.clear();
+    int count = (int)posX.size();
+    float diameter2 = 4.0f * circle.m_radius * circle.m_radius;
+    const int offsetX[] = { 1, -1, 0, 1 };
+    const int offsetY[] = { 0, 1, 1, 1 };
+
+    for (int i = 0; i < count; i++)
+    {
+        int cell = cellOf[i];
+        int cx = cell % cellsX;
+        int cy = cell / cellsX;
+
+        for (int j = i + 1; j < cellStart[cell + 1]; j++)
+        {
+            float dx = posX[j] - posX[i];
+            float dy = posY[j] - posY[i];
+            if (dx * dx + dy * dy < diameter2)
+            {
+                pairA.push_back(i);
+                pairB.push_back(j);
+            }
+        }
+
+        for (int n = 0; n < 4; n++)
+        {
+            int nx = cx + offsetX[n];
+            int ny = cy + offsetY[n];
+            if (nx < 0 || nx >= cellsX || ny >= cellsY)
+                continue;
+            int neighbor = ny * cellsX + nx;
+            for (int j = cellStart[neighbor]; j < cellStart[neighbor + 1]; j++)
+            {
+                float dx = posX[j] - posX[i];
+                float dy = posY[j] - posY[i];
+                if (dx * dx + dy * dy < diameter2)
+                {
+                    pairA.push_back(i);
+                    pairB.push_back(j);
+                }
+            }
+        }
+    }
+}
+
+// Una pasada de Gauss-Seidel sobre los pares: impulso con restitucin si se
+// acercan y correccin de la mitad del solapamiento repartida entre los dos
+void ParticleSwarm::SolvePairs()
+{
+    float diameter = 2.0f * circle.m_radius;
+    for (size_t k = 0; k < pairA.size(); k++)
+    {
+        int a = pairA[k];
+        int b = pairB[k];
+        float dx = posX[b] - posX[a];
+        float dy = posY[b] - posY[a];
+        float d2 = dx * dx + dy * dy;
+        if (d2 >= diameter * diameter || d2 < b2_epsilon)
+            continue;
+
+        float d = sqrtf(d2);
+        float nx = dx / d;
+        float ny = dy / d;
+
+        float vn = (velX[b] - velX[a]) * nx + (velY[b] - velY[a]) * ny;
+        if (vn < 0.0f)
+        {
+            float j = -0.5f * (1.0f + restitution) * vn;
+            velX[a] -= j * nx;
+            velY[a] -= j * ny;
+            velX[b] += j * nx;
+            velY[b] += j * ny;
+        }
+
+        float correction = 0.25f * (diameter - d);
+        posX[a] -= correction * nx;
+        posY[a] -= correction * ny;
+        posX[b] += correction * nx;
+        posY[b] += correction * ny;
+    }
+}
+
+// Mismo filtro que box2d entre la capa del enjambre y el fixture
+bool ParticleSwarm::ColliderQuery::ReportFixture(b2Fixture* fixture)
+{
+    if (fixture->IsSensor())
+        return true;
+    const b2Filter& other = fixture->GetFilterData();
+    if ((owner->filter.maskBits & other.categoryBits) == 0 || (owner->filter.categoryBits & other.maskBits) == 0)
+        return true;
+
+    owner->colliders.push_back(fixture);
+    return true;
+}
+
+// Partculas de las celdas que cubre el AABB del hijo del fixture
+void ParticleSwarm::CollideFixture(b2Fixture* fixture, int32 child)
+{
+    const b2Transform& xf = fixture->GetBody()->GetTransform();
+    const b2Shape* shape = fixture->GetShape();
+    b2EdgeShape edge;
+    if (shape->GetType() == b2Shape::e_chain)
+    {
+        ((const b2ChainShape*)shape)->GetChildEdge(&edge, child);
+        shape = &edge;
+    }
+
+    b2AABB aabb;
+    shape->ComputeAABB(&aabb, xf, 0);
+    float r = circle.m_radius;
+    if (aabb.upperBound.x + r < bounds.lowerBound.x || aabb.lowerBound.x - r > bounds.upperBound.x
+        || aabb.upperBound.y + r < bounds.lowerBound.y || aabb.lowerBound.y - r > bounds.upperBound.y)
+        return;
+
+    int x0 = CellX(aabb.lowerBound.x - r);
+    int x1 = CellX(aabb.upperBound.x + r);
+    int y0 = CellY(aabb.lowerBound.y - r);
+    int y1 = CellY(aabb.upperBound.y + r);
+    for (int cy = y0; cy <= y1; cy++)
+    {
+        for (int cx = x0; cx <= x1; cx++)
+        {
+            int cell = cy * cellsX + cx;
+            for (int i = cellStart[cell]; i < cellStart[cell + 1]; i++)
+                CollideParticle(i, fixture, shape, xf);
+        }
+    }
+}
+
+// Choque de una partcula con un shape del mundo. Contra un body dinmico el
+// impulso se reparte segn las masas y el body recibe el opuesto
+void ParticleSwarm::CollideParticle(int i, b2Fixture* fixture, const b2Shape* shape, const b2Transform& xf)
+{
+    b2Transform xfB;
+    xfB.Set(b2Vec2(posX[i], posY[i]), 0.0f);
+
+    b2Manifold manifold;
+    switch (shape->GetType())
+    {
+    case b2Shape::e_circle:
+        b2CollideCircles(&manifold, (const b2CircleShape*)shape, xf, &circle, xfB);
+        break;
+    case b2Shape::e_polygon:
+        b2CollidePolygonAndCircle(&manifold, (const b2PolygonShape*)shape, xf, &circle, xfB);
+        break;
+    case b2Shape::e_edge:
+        b2CollideEdgeAndCircle(&manifold, (const b2EdgeShape*)shape, xf, &circle, xfB);
+        break;
+    default:
+        return;
+    }
+    if (manifold.pointCount == 0)
+        return;
+
+    b2WorldManifold wm;
+    wm.Initialize(&manifold, xf, shape->m_radius, xfB, circle.m_radius);
+    b2Vec2 n = wm.normal; // del shape hacia la partcula
+    b2Vec2 point = wm.points[0];
+
+    // Fuera del shape
+    posX[i] -= wm.separations[0] * n.x;
+    posY[i] -= wm.separations[0] * n.y;
+
+    b2Body* body = fixture->GetBody();
+    b2Vec2 v(velX[i], velY[i]);
+    b2Vec2 relative = v - body->GetLinearVelocityFromWorldPoint(point);
+    float vn = b2Dot(relative, n);
+    if (vn >= 0.0f)
+        return;
+
+    float e = b2Max(restitution, fixture->GetRestitution());
+    float invMass = 1.0f / mass;
+    float k = invMass;
+    if (body->GetType() == b2_dynamicBody)
+    {
+        float bodyMass = body->GetMass();
+        b2Vec2 localCenter = body->GetLocalCenter();
+        float centralInertia = body->GetInertia() - bodyMass * b2Dot(localCenter, localCenter);
+        float rn = b2Cross(point - body->GetWorldCenter(), n);
+        k += (bodyMass > 0.0f ? 1.0f / bodyMass : 0.0f) + (centralInertia > 0.0f ? rn * rn / centralInertia : 0.0f);
+    }
+    float j = -(1.0f + e) * vn / k;
+    v += (j * invMass) * n;
+
+    // Friccin de Coulomb simplificada: el impulso tangente no pasa de friction * j
+    b2Vec2 tangent = relative - vn * n;
+    float vt = tangent.Length();
+    if (vt > b2_epsilon)
+    {
+        float drop = b2Min(vt, fixture->GetFriction() * j * invMass);
+        v -= (drop / vt) * tangent;
+    }
+
+    velX[i] = v.x;
+    velY[i] = v.y;
+    if (body->GetType() == b2_dynamicBody)
+        body->ApplyLinearImpulse(-j * n, point, true);
+}
+
+int ParticleSwarm::RemoveOutside(const b2AABB& area)
+{
+    b2AABB meters;
+    meters.lowerBound = WorldUnits::ToMeters(area.lowerBound);
+    meters.upperBound = WorldUnits::ToMeters(area.upperBound);
+
+    int removed = 0;
+    for (int i = (int)posX.size() - 1; i >= 0; i--)
+    {
+        if (posX[i] >= meters.lowerBound.x && posX[i] <= meters.upperBound.x
+            && posY[i] >= meters.lowerBound.y && posY[i] <= meters.upperBound.y)
+            continue;
+
+        posX[i] = posX.back();
+        posY[i] = posY.back();
+        velX[i] = velX.back();
+        velY[i] = velY.back();
+        posX.pop_back();
+        posY.pop_back();
+        velX.pop_back();
+        velY.pop_back();
+        removed++;
+    }
+    return removed;
+}
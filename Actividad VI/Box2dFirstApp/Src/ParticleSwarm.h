@@ -0,0 +1,96 @@
+//-----------------------------------------------------
+//Enjambre de crculos chicos e iguales fuera del b2World.
+//Cada partcula es una posicin y una velocidad en
+//arreglos paralelos; no tiene body, fixture ni proxy en
+//el broadphase. Step integra con la gravedad del mundo,
+//ordena las partculas por celda de una grilla uniforme
+//(counting sort, que adems las deja contiguas en
+//memoria por celda), arma los pares con las celdas
+//vecinas y resuelve los choques entre partculas con
+//impulsos y correccin de posicin. Los fixtures del
+//mundo que tocan el enjambre se consultan una vez por
+//paso: contra los estticos y cinemticos la partcula
+//rebota sola y a los dinmicos se les aplica el impulso
+//opuesto, as el acople va en los dos sentidos
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <vector>
+#include "CollisionLayers.h"
+
+class ParticleSwarm
+{
+private:
+	b2World* world;
+	b2CircleShape circle;		// forma de una partcula en metros, centrada en el origen
+	b2Filter filter;
+	float mass;
+	float restitution;
+	int capacity;
+
+	// Estado de cada partcula (metros y metros por segundo)
+	std::vector<float> posX;
+	std::vector<float> posY;
+	std::vector<float> velX;
+	std::vector<float> velY;
+
+	// Grilla uniforme de celdas del dimetro de una partcula
+	b2Vec2 gridOrigin;
+	float cellSize;
+	int cellsX;
+	int cellsY;
+	std::vector<int> cellOf;		// celda de cada partcula
+	std::vector<int> cellStart;		// partculas de la celda c: [cellStart[c], cellStart[c + 1])
+	std::vector<int> order;			// lugar de cada partcula despus del counting sort
+	std::vector<float> scratch;
+
+	// Pares a menos de un dimetro
+	std::vector<int> pairA;
+	std::vector<int> pairB;
+
+	// Fixtures del mundo que tocan el AABB del enjambre
+	struct ColliderQuery : public b2QueryCallback
+	{
+		ParticleSwarm* owner;
+		bool ReportFixture(b2Fixture* fixture) override;
+	};
+	std::vector<b2Fixture*> colliders;
+	b2AABB bounds;
+	float maxSpeed;
+
+	void Integrate(float dt);
+	void BuildGrid();
+	void FindPairs();
+	void SolvePairs();
+	void CollideFixture(b2Fixture* fixture, int32 child);
+	void CollideParticle(int i, b2Fixture* fixture, const b2Shape* shape, const b2Transform& xf);
+	void Reorder(std::vector<float>& values);
+	int CellX(float x) const;
+	int CellY(float y) const;
+
+public:
+	// radius en unidades de render; density da la masa de cada partcula para el acople
+	ParticleSwarm(b2World* world, float radius, float density, float restitution, CollisionLayer layer, int capacity);
+
+	// Agrega una partcula (position y velocity en unidades de render). Devuelve false si no hay lugar
+	bool Add(b2Vec2 position, b2Vec2 velocity);
+
+	// Avanza dt segundos: integracin, grilla, choques entre partculas (iterations
+	// pasadas) y contra los fixtures del mundo. No se puede llamar durante b2World::Step
+	void Step(float dt, int iterations = 2);
+
+	// Quita las partculas que quedaron fuera de area (en unidades de render)
+	int RemoveOutside(const b2AABB& area);
+
+	int GetCount() const { return (int)posX.size(); }
+	int GetCapacity() const { return capacity; }
+	int GetPairCount() const { return (int)pairA.size(); }
+	float GetRadius() const { return circle.m_radius; }
+
+	// Rapidez de la partcula ms rpida en el ltimo Step (metros por segundo)
+	float GetMaxSpeed() const { return maxSpeed; }
+
+	const float* GetPositionX() const { return posX.empty() ? nullptr : &posX[0]; }
+	const float* GetPositionY() const { return posY.empty() ? nullptr : &posY[0]; }
+};
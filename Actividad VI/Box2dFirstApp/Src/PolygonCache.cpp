@@ -0,0 +1,272 @@
+#include "PolygonCache.h"
+#include "WorldUnits.h"
+#include <algorithm>
+#include <cstring>
+
+PolygonCache::PolygonCache()
+{
+    hits = 0;
+    misses = 0;
+}
+
+// FNV-1a sobre los bits de las coordenadas y de la escala
+PolygonCache::Key PolygonCache::Hash(const b2Vec2* v, int n, float unitsPerMeter)
+{
+    Key hash = 14695981039346656037ull;
+    const unsigned char* bytes = (const unsigned char*)v;
+    for (size_t i = 0; i < n * sizeof(b2Vec2); i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    bytes = (const unsigned char*)&unitsPerMeter;
+    for (size_t i = 0; i < sizeof(float); i++)
+    {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash ^ (Key)n;
+}
+
+const PolygonCache::Entry& PolygonCache::Get(const b2Vec2* v, int n)
+{
+    float unitsPerMeter = WorldUnits::GetUnitsPerMeter();
+    std::deque<Entry>& bucket = entries[Hash(v, n, unitsPerMeter)];
+    for (const Entry& entry : bucket)
+    {
+        if (entry.unitsPerMeter == unitsPerMeter && (int)entry.outline.size() == n
+            && memcmp(&entry.outline[0], v, n * sizeof(b2Vec2)) == 0)
+        {
+            hits++;
+            return entry;
+        }
+    }
+
+    misses++;
+    bucket.emplace_back();
+    Entry& entry = bucket.back();
+    entry.outline.assign(v, v + n);
+    entry.unitsPerMeter = unitsPerMeter;
+    Decompose(v, n, entry);
+    return entry;
+}
+
+// Particin del contorno en piezas convexas y masa total con densidad 1
+void PolygonCache::Decompose(const b2Vec2* v, int n, Entry& entry)
+{
+    entry.unitMass.mass = 0.0f;
+    entry.unitMass.center.SetZero();
+    entry.unitMass.I = 0.0f;
+
+    // Vrtices en metros sin repetidos seguidos (box2d los soldara)
+    std::vector<b2Vec2> points;
+    for (int i = 0; i < n; i++)
+    {
+        b2Vec2 p = WorldUnits::ToMeters(v[i]);
+        if (points.empty() || b2DistanceSquared(points.back(), p) > b2_linearSlop * b2_linearSlop)
+            points.push_back(p);
+    }
+    while (points.size() > 1 && b2DistanceSquared(points.front(), points.back()) <= b2_linearSlop * b2_linearSlop)
+        points.pop_back();
+    if (points.size() < 3)
+        return;
+
+    // Ear clipping y la convexidad se miden con el contorno antihorario
+    float area = 0.0f;
+    for (size_t i = 0; i < points.size(); i++)
+        area += b2Cross(points[i], points[(i + 1) % points.size()]);
+    if (area < 0.0f)
+        std::reverse(points.begin(), points.end());
+
+    std::vector<std::vector<int>> polygons;
+    Triangulate(points, polygons);
+    MergeConvex(points, polygons);
+
+    b2Vec2 weighted(0.0f, 0.0f);
+    for (const std::vector<int>& polygon : polygons)
+    {
+        b2Vec2 verts[b2_maxPolygonVertices];
+        int count = (int)polygon.size();
+        float pieceArea = 0.0f;
+        for (int i = 0; i < count; i++)
+        {
+            verts[i] = points[polygon[i]];
+            pieceArea += b2Cross(verts[i], points[polygon[(i + 1) % count]]);
+        }
+
+        // Astillas que box2d no puede armar (vrtices soldados, rea casi nula)
+        if (0.5f * pieceArea < 4.0f * b2_linearSlop * b2_linearSlop)
+            continue;
+
+        b2PolygonShape piece;
+        piece.Set(verts, count);
+        entry.pieces.push_back(piece);
+
+        b2MassData massData;
+        piece.ComputeMass(&massData, 1.0f);
+        entry.unitMass.mass += massData.mass;
+        entry.unitMass.I += massData.I;
+        weighted += massData.mass * massData.center;
+    }
+
+    if (entry.unitMass.mass > 0.0f)
+        entry.unitMass.center = (1.0f / entry.unitMass.mass) * weighted;
+}
+
+// Incluye los bordes: un vrtice sobre el borde tambin impide la oreja
+static bool InTriangle(const b2Vec2& p, const b2Vec2& a, const b2Vec2& b, const b2Vec2& c)
+{
+    return b2Cross(b - a, p - a) >= 0.0f && b2Cross(c - b, p - b) >= 0.0f && b2Cross(a - c, p - c) >= 0.0f;
+}
+
+// Ear clipping O(n^2). Si no queda ninguna oreja (contorno con cruces o
+// vrtices colineales) se descarta el vrtice ms plano y se sigue
+void PolygonCache::Triangulate(const std::vector<b2Vec2>& points, std::vector<std::vector<int>>& polygons)
+{
+    std::vector<int> remaining((int)points.size());
+    for (int i = 0; i < (int)points.size(); i++)
+        remaining[i] = i;
+
+    while (remaining.size() > 3)
+    {
+        int m = (int)remaining.size();
+        int flattest = 0;
+        float flattestCross = b2_maxFloat;
+        bool clipped = false;
+        for (int i = 0; i < m && !clipped; i++)
+        {
+            int prev = remaining[(i + m - 1) % m];
+            int cur = remaining[i];
+            int next = remaining[(i + 1) % m];
+            const b2Vec2& a = points[prev];
+            const b2Vec2& b = points[cur];
+            const b2Vec2& c = points[next];
+
+            float cross = b2Cross(b - a, c - b);
+            if (b2Abs(cross) < flattestCross)
+            {
+                flattestCross = b2Abs(cross);
+                flattest = i;
+            }
+            if (cross <= 0.0f)
+                continue; // reflejo o colineal
+
+            bool ear = true;
+            for (int k : remaining)
+            {
+                if (k != prev && k != cur && k != next && InTriangle(points[k], a, b, c))
+                {
+                    ear = false;
+                    break;
+                }
+            }
+            if (!ear)
+                continue;
+
+            polygons.push_back({ prev, cur, next });
+            remaining.erase(remaining.begin() + i);
+            clipped = true;
+        }
+
+        if (!clipped)
+            remaining.erase(remaining.begin() + flattest);
+    }
+
+    if (remaining.size() == 3 && b2Cross(points[remaining[1]] - points[remaining[0]], points[remaining[2]] - points[remaining[1]]) > 0.0f)
+        polygons.push_back(remaining);
+}
+
+// Hertel-Mehlhorn: se quita cada diagonal entre dos piezas si la unin sigue
+// siendo convexa y no pasa de b2_maxPolygonVertices
+void PolygonCache::MergeConvex(const std::vector<b2Vec2>& points, std::vector<std::vector<int>>& polygons)
+{
+    bool merged = true;
+    while (merged)
+    {
+        merged = false;
+        for (size_t a = 0; a < polygons.size() && !merged; a++)
+        {
+            for (size_t b = a + 1; b < polygons.size() && !merged; b++)
+            {
+                const std::vector<int>& A = polygons[a];
+                const std::vector<int>& B = polygons[b];
+                int sizeA = (int)A.size();
+                int sizeB = (int)B.size();
+                if (sizeA + sizeB - 2 > b2_maxPolygonVertices)
+                    continue;
+
+                for (int ka = 0; ka < sizeA && !merged; ka++)
+                {
+                    int u = A[ka];
+                    int w = A[(ka + 1) % sizeA];
+                    int kb = 0;
+                    while (kb < sizeB && !(B[kb] == w && B[(kb + 1) % sizeB] == u))
+                        kb++;
+                    if (kb == sizeB)
+                        continue;
+
+                    // A desde w hasta u y despus B entre u y w
+                    std::vector<int> joined;
+                    for (int i = 0; i < sizeA; i++)
+                        joined.push_back(A[(ka + 1 + i) % sizeA]);
+                    for (int i = 2; i < sizeB; i++)
+                        joined.push_back(B[(kb + i) % sizeB]);
+
+                    if (IsConvex(points, joined))
+                    {
+                        polygons[a] = joined;
+                        polygons.erase(polygons.begin() + b);
+                        merged = true;
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Los vrtices colineales se aceptan: b2PolygonShape::Set los quita de la cscara
+bool PolygonCache::IsConvex(const std::vector<b2Vec2>& points, const std::vector<int>& polygon)
+{
+    int count = (int)polygon.size();
+    for (int i = 0; i < count; i++)
+    {
+        const b2Vec2& a = points[polygon[i]];
+        const b2Vec2& b = points[polygon[(i + 1) % count]];
+        const b2Vec2& c = points[polygon[(i + 2) % count]];
+        if (b2Cross(b - a, c - b) < -b2_epsilon)
+            return false;
+    }
+    return true;
+}
+
+// Con densidad 0 CreateFixture no llama a ResetMassData; SetDensity tampoco
+void PolygonCache::Attach(b2Body* body, const Entry& entry, float density, float friction, float restitution, const b2Filter& filter)
+{
+    bool hadFixtures = body->GetFixtureList() != nullptr;
+
+    b2FixtureDef def;
+    def.density = 0.0f;
+    def.friction = friction;
+    def.restitution = restitution;
+    def.filter = filter;
+    for (const b2PolygonShape& piece : entry.pieces)
+    {
+        def.shape = &piece;
+        body->CreateFixture(&def)->SetDensity(density);
+    }
+
+    if (body->GetType() != b2_dynamicBody)
+        return;
+
+    // Si el body ya tena otras formas la masa guardada no alcanza
+    if (hadFixtures)
+    {
+        body->ResetMassData();
+        return;
+    }
+
+    b2MassData massData = entry.unitMass;
+    massData.mass *= density;
+    massData.I *= density;
+    body->SetMassData(&massData);
+}
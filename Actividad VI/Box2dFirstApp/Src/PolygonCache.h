@@ -0,0 +1,63 @@
+//-----------------------------------------------------
+//Polgonos cncavos y de ms de b2_maxPolygonVertices
+//vrtices. Box2DHelper::CreatePolyFixtureDef rechaza
+//los contornos de ms de 8 vrtices y b2PolygonShape::Set
+//calcula la cscara convexa en cada llamada. PolygonCache parte el
+//contorno una sola vez en tringulos (ear clipping) y
+//los junta en piezas convexas de hasta 8 vrtices
+//(Hertel-Mehlhorn); las piezas ya armadas y la masa con
+//densidad 1 quedan guardadas con un hash de los
+//vrtices y de la escala de WorldUnits, as cada
+//aparicin del mismo contorno solo copia las formas y
+//un cambio de SetUnitsPerMeter no devuelve piezas con
+//la escala vieja. Attach crea todos los fixtures con
+//densidad 0 (box2d no recalcula la masa por fixture) y
+//asigna la masa guardada al final
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+
+class PolygonCache
+{
+public:
+	typedef unsigned long long Key;
+
+	// Contorno ya partido
+	struct Entry
+	{
+		std::vector<b2Vec2> outline;			// vrtices originales en unidades de render
+		float unitsPerMeter;					// escala con la que se pasaron a metros
+		std::vector<b2PolygonShape> pieces;		// piezas convexas en metros
+		b2MassData unitMass;					// masa con densidad 1 (I respecto del origen del body)
+	};
+
+private:
+	std::unordered_map<Key, std::deque<Entry>> entries;	// varias por si dos contornos comparten hash
+	int hits;
+	int misses;
+
+	static Key Hash(const b2Vec2* v, int n, float unitsPerMeter);
+	static void Decompose(const b2Vec2* v, int n, Entry& entry);
+	static void Triangulate(const std::vector<b2Vec2>& points, std::vector<std::vector<int>>& polygons);
+	static void MergeConvex(const std::vector<b2Vec2>& points, std::vector<std::vector<int>>& polygons);
+	static bool IsConvex(const std::vector<b2Vec2>& points, const std::vector<int>& polygon);
+
+public:
+	PolygonCache();
+
+	// Piezas del contorno v (n vrtices en unidades de render, sin repetir el primero
+	// y sin que se cruce). Lo parte la primera vez y despus lo devuelve de la cach.
+	// Con otra escala de WorldUnits se vuelve a partir. La referencia vale hasta Clear
+	const Entry& Get(const b2Vec2* v, int n);
+
+	// Agrega una pieza por fixture al body y le asigna la masa guardada por density
+	static void Attach(b2Body* body, const Entry& entry, float density, float friction, float restitution, const b2Filter& filter);
+
+	void Clear() { entries.clear(); }
+	int GetHitCount() const { return hits; }
+	int GetMissCount() const { return misses; }
+};
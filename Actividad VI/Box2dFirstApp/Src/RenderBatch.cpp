@@ -0,0 +1,254 @@
+#include "RenderBatch.h"
+#include "WorldUnits.h"
+#include <algorithm>
+
+// Constructor: reserva el buffer de vrtices y arma el crculo unitario
+RenderBatch::RenderBatch(int maxVertices, int circleSegments)
+{
+    this->circleSegments = circleSegments < 3 ? 3 : circleSegments;
+    vertexCount = 0;
+
+    for (int k = 0; k <= this->circleSegments; k++)
+    {
+        float angle = 2.0f * b2_pi * k / this->circleSegments;
+        ringCos.push_back(cosf(angle));
+        ringSin.push_back(sinf(angle));
+    }
+
+    localX.resize(maxVertices);
+    localY.resize(maxVertices);
+    owner.resize(maxVertices);
+    vertices.resize(maxVertices);
+}
+
+// Mismos colores que b2World::DebugDraw segn el estado del body
+sf::Color RenderBatch::BodyColor(const b2Body* body)
+{
+    b2Color color;
+    if (!body->IsEnabled())
+        color.Set(0.5f, 0.5f, 0.3f);
+    else if (body->GetType() == b2_staticBody)
+        color.Set(0.5f, 0.9f, 0.5f);
+    else if (body->GetType() == b2_kinematicBody)
+        color.Set(0.5f, 0.5f, 0.9f);
+    else if (!body->IsAwake())
+        color.Set(0.6f, 0.6f, 0.6f);
+    else
+        color.Set(0.9f, 0.7f, 0.7f);
+
+    return sf::Color((sf::Uint8)(color.r * 255), (sf::Uint8)(color.g * 255), (sf::Uint8)(color.b * 255));
+}
+
+// Vrtices de tringulos que ocupa un shape (0 para edge y chain)
+int RenderBatch::CountVertices(const b2Shape* shape) const
+{
+    switch (shape->GetType())
+    {
+    case b2Shape::e_circle:
+        return 3 * circleSegments;
+    case b2Shape::e_polygon:
+        return 3 * (((const b2PolygonShape*)shape)->m_count - 2);
+    default:
+        return 0;
+    }
+}
+
+// Acumula todos los fixtures que toca la consulta
+bool RenderBatch::FixtureQuery::ReportFixture(b2Fixture* fixture)
+{
+    fixtures.push_back(fixture);
+    return true;
+}
+
+// Anota un registro por fixture y las transformaciones de los bodies
+void RenderBatch::Gather(const b2World* world)
+{
+    Begin();
+    for (const b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+    {
+        int transform = AddTransform(body);
+        sf::Color color = BodyColor(body);
+        for (const b2Fixture* f = body->GetFixtureList(); f; f = f->GetNext())
+            AddFixture(f, transform, color);
+    }
+    End();
+}
+
+// Solo los fixtures visibles; cada uno lleva la transformacin de su body
+// (un body con varios fixtures visibles la repite, a cambio de no buscarla)
+void RenderBatch::Gather(const b2World* world, const b2AABB& bounds)
+{
+    query.fixtures.clear();
+    world->QueryAABB(&query, bounds);
+    // Un fixture de cadena aparece una vez por cada hijo
+    std::sort(query.fixtures.begin(), query.fixtures.end());
+    query.fixtures.erase(std::unique(query.fixtures.begin(), query.fixtures.end()), query.fixtures.end());
+
+    Begin();
+    for (const b2Fixture* f : query.fixtures)
+    {
+        const b2Body* body = f->GetBody();
+        AddFixture(f, AddTransform(body), BodyColor(body));
+    }
+    End();
+}
+
+void RenderBatch::Begin()
+{
+    shapes.clear();
+    lines.clear();
+    posX.clear();
+    posY.clear();
+    cosA.clear();
+    sinA.clear();
+    vertexCount = 0;
+}
+
+// Guarda la transformacin del body y devuelve su ndice
+int RenderBatch::AddTransform(const b2Body* body)
+{
+    const b2Transform& xf = body->GetTransform();
+    posX.push_back(xf.p.x);
+    posY.push_back(xf.p.y);
+    cosA.push_back(xf.q.c);
+    sinA.push_back(xf.q.s);
+    return (int)posX.size() - 1;
+}
+
+// Registro del fixture (los segmentos se pasan a mundo ac mismo)
+void RenderBatch::AddFixture(const b2Fixture* fixture, int transform, const sf::Color& color)
+{
+    const float scale = WorldUnits::GetUnitsPerMeter();
+    const b2Shape* shape = fixture->GetShape();
+    const b2Transform& xf = fixture->GetBody()->GetTransform();
+
+    if (shape->GetType() == b2Shape::e_edge)
+    {
+        const b2EdgeShape* edge = (const b2EdgeShape*)shape;
+        b2Vec2 a = scale * b2Mul(xf, edge->m_vertex1);
+        b2Vec2 b = scale * b2Mul(xf, edge->m_vertex2);
+        lines.push_back(sf::Vertex(sf::Vector2f(a.x, a.y), color));
+        lines.push_back(sf::Vertex(sf::Vector2f(b.x, b.y), color));
+        return;
+    }
+    if (shape->GetType() == b2Shape::e_chain)
+    {
+        const b2ChainShape* chain = (const b2ChainShape*)shape;
+        for (int32 i = 0; i + 1 < chain->m_count; i++)
+        {
+            b2Vec2 a = scale * b2Mul(xf, chain->m_vertices[i]);
+            b2Vec2 b = scale * b2Mul(xf, chain->m_vertices[i + 1]);
+            lines.push_back(sf::Vertex(sf::Vector2f(a.x, a.y), color));
+            lines.push_back(sf::Vertex(sf::Vector2f(b.x, b.y), color));
+        }
+        return;
+    }
+
+    ShapeRecord record;
+    record.shape = shape;
+    record.transform = transform;
+    record.firstVertex = vertexCount;
+    record.color = color;
+    shapes.push_back(record);
+    vertexCount += CountVertices(shape);
+}
+
+// Solo crece: el buffer se reusa frame a frame
+void RenderBatch::End()
+{
+    if (vertexCount > (int)vertices.size())
+    {
+        localX.resize(vertexCount);
+        localY.resize(vertexCount);
+        owner.resize(vertexCount);
+        vertices.resize(vertexCount);
+    }
+}
+
+// Tringulos del shape en coordenadas del body (metros) y color de salida
+void RenderBatch::WriteLocal(const ShapeRecord& record)
+{
+    int v = record.firstVertex;
+    int count = CountVertices(record.shape);
+
+    if (record.shape->GetType() == b2Shape::e_circle)
+    {
+        const b2CircleShape* circle = (const b2CircleShape*)record.shape;
+        b2Vec2 c = circle->m_p;
+        float r = circle->m_radius;
+        for (int k = 0; k < circleSegments; k++)
+        {
+            localX[v] = c.x;
+            localY[v] = c.y;
+            localX[v + 1] = c.x + r * ringCos[k];
+            localY[v + 1] = c.y + r * ringSin[k];
+            localX[v + 2] = c.x + r * ringCos[k + 1];
+            localY[v + 2] = c.y + r * ringSin[k + 1];
+            v += 3;
+        }
+    }
+    else
+    {
+        // Abanico desde el primer vrtice (los polgonos de box2d son convexos)
+        const b2PolygonShape* polygon = (const b2PolygonShape*)record.shape;
+        const b2Vec2* p = polygon->m_vertices;
+        for (int32 k = 1; k + 1 < polygon->m_count; k++)
+        {
+            localX[v] = p[0].x;
+            localY[v] = p[0].y;
+            localX[v + 1] = p[k].x;
+            localY[v + 1] = p[k].y;
+            localX[v + 2] = p[k + 1].x;
+            localY[v + 2] = p[k + 1].y;
+            v += 3;
+        }
+    }
+
+    for (int i = record.firstVertex; i < record.firstVertex + count; i++)
+    {
+        owner[i] = record.transform;
+        vertices[i].color = record.color;
+    }
+}
+
+// Arma los shapes [begin, end) de esta parte: primero los vrtices locales y
+// despus la transformacin a mundo en un solo bucle sobre los arreglos planos
+void RenderBatch::Build(int part, int parts)
+{
+    int shapeCount = (int)shapes.size();
+    int begin = shapeCount * part / parts;
+    int end = shapeCount * (part + 1) / parts;
+    if (begin >= end)
+        return;
+
+    for (int s = begin; s < end; s++)
+        WriteLocal(shapes[s]);
+
+    int first = shapes[begin].firstVertex;
+    int last = end < shapeCount ? shapes[end].firstVertex : vertexCount;
+
+    const float scale = WorldUnits::GetUnitsPerMeter();
+    const float* lx = &localX[0];
+    const float* ly = &localY[0];
+    const int* t = &owner[0];
+    const float* px = &posX[0];
+    const float* py = &posY[0];
+    const float* c = &cosA[0];
+    const float* s = &sinA[0];
+    sf::Vertex* out = &vertices[0];
+    for (int i = first; i < last; i++)
+    {
+        int k = t[i];
+        out[i].position.x = (px[k] + c[k] * lx[i] - s[k] * ly[i]) * scale;
+        out[i].position.y = (py[k] + s[k] * lx[i] + c[k] * ly[i]) * scale;
+    }
+}
+
+// Una llamada para todos los tringulos y otra para los segmentos
+void RenderBatch::Draw(sf::RenderTarget& target) const
+{
+    if (vertexCount > 0)
+        target.draw(&vertices[0], vertexCount, sf::Triangles);
+    if (!lines.empty())
+        target.draw(&lines[0], lines.size(), sf::Lines);
+}
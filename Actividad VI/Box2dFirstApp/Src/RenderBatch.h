@@ -0,0 +1,91 @@
+//-----------------------------------------------------
+//Preparacin del dibujo de todos los fixtures en un
+//solo arreglo de tringulos. Gather recorre el mundo en
+//el hilo que lo llama y solo anota un registro por
+//fixture (body, shape, color y dnde van sus vrtices).
+//Build(part, parts) arma una parte de los registros:
+//escribe los vrtices locales de sus shapes en arreglos
+//planos (x por un lado, y por el otro) y los pasa a
+//coordenadas de mundo con un bucle sin ramas sobre esos
+//arreglos, que el compilador puede vectorizar. Las
+//partes no comparten datos, as que corren en paralelo
+//en el JobSystem. Draw entrega el buffer en una llamada.
+//Gather con un rectngulo solo anota los fixtures que
+//devuelve QueryAABB (lo que se ve ms un margen)
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <SFML/Graphics.hpp>
+#include <vector>
+
+class RenderBatch
+{
+private:
+	// Un fixture a dibujar
+	struct ShapeRecord
+	{
+		const b2Shape* shape;
+		int transform;		// ndice en los arreglos de transformaciones
+		int firstVertex;	// primer vrtice de salida
+		sf::Color color;
+	};
+
+	// Lados de los crculos y crculo unitario
+	int circleSegments;
+	std::vector<float> ringCos;
+	std::vector<float> ringSin;
+
+	std::vector<ShapeRecord> shapes;
+
+	// Transformacin de cada body (separadas por componente)
+	std::vector<float> posX;
+	std::vector<float> posY;
+	std::vector<float> cosA;
+	std::vector<float> sinA;
+
+	// Vrtices de tringulos: locales, dueo y resultado en unidades de render
+	std::vector<float> localX;
+	std::vector<float> localY;
+	std::vector<int> owner;
+	std::vector<sf::Vertex> vertices;
+	int vertexCount;
+
+	// Segmentos (edge y chain), se arman en Gather porque son pocos y estticos
+	std::vector<sf::Vertex> lines;
+
+	// Fixtures que devuelve la consulta del rectngulo visible
+	struct FixtureQuery : public b2QueryCallback
+	{
+		std::vector<b2Fixture*> fixtures;
+		bool ReportFixture(b2Fixture* fixture) override;
+	};
+	FixtureQuery query;
+
+	void Begin();
+	int AddTransform(const b2Body* body);
+	void AddFixture(const b2Fixture* fixture, int transform, const sf::Color& color);
+	void End();
+	int CountVertices(const b2Shape* shape) const;
+	void WriteLocal(const ShapeRecord& record);
+	static sf::Color BodyColor(const b2Body* body);
+
+public:
+	// maxVertices se reserva de entrada; si la escena crece el buffer se agranda en Gather
+	RenderBatch(int maxVertices, int circleSegments = 12);
+
+	// Anota los fixtures del mundo (no debe correr junto a Step)
+	void Gather(const b2World* world);
+
+	// Igual pero solo con los fixtures que tocan bounds (metros)
+	void Gather(const b2World* world, const b2AABB& bounds);
+
+	// Arma la parte part de parts; se puede llamar en paralelo con partes distintas
+	void Build(int part, int parts);
+
+	// Entrega los tringulos y los segmentos al target
+	void Draw(sf::RenderTarget& target) const;
+
+	int GetShapeCount() const { return (int)shapes.size(); }
+	int GetVertexCount() const { return vertexCount; }
+};
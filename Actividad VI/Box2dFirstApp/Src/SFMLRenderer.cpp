@@ -1,4 +1,6 @@
 #include "SFMLRenderer.h"
+#include "WorldUnits.h"
+#include <algorithm>
 
 // Constructor de la clase SFMLRenderer
 SFMLRenderer::SFMLRenderer(RenderWindow* window)
@@ -19,7 +21,7 @@ void SFMLRenderer::DrawPolygon(const b2Vec2* vertices, int32 vertexCount, const
 
     polygon.setPointCount(vertexCount);
     for (int i = 0; i < vertexCount; ++i)
-        polygon.setPoint(i, Vector2f(vertices[i].x, vertices[i].y)); // Establece los vrtices del polgono
+        polygon.setPoint(i, Vector2f(WorldUnits::ToUnits(vertices[i].x), WorldUnits::ToUnits(vertices[i].y))); // Establece los vrtices del polgono
 
     wnd->draw(polygon); // Dibuja el polgono en la ventana
 }
@@ -33,7 +35,7 @@ void SFMLRenderer::DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, c
 
     polygon.setPointCount(vertexCount);
     for (int i = 0; i < vertexCount; ++i)
-        polygon.setPoint(i, Vector2f(vertices[i].x, vertices[i].y)); // Establece los vrtices del polgono
+        polygon.setPoint(i, Vector2f(WorldUnits::ToUnits(vertices[i].x), WorldUnits::ToUnits(vertices[i].y))); // Establece los vrtices del polgono
 
     wnd->draw(polygon); // Dibuja el polgono en la ventana
 }
@@ -41,9 +43,11 @@ void SFMLRenderer::DrawSolidPolygon(const b2Vec2* vertices, int32 vertexCount, c
 // Dibuja un crculo sin relleno
 void SFMLRenderer::DrawCircle(const b2Vec2& center, float radius, const b2Color& color)
 {
-    sf::CircleShape circle(radius);
-    circle.setOrigin(radius, radius);
-    circle.setPosition(center.x, center.y);
+    float r = WorldUnits::ToUnits(radius);
+    b2Vec2 c = WorldUnits::ToUnits(center);
+    sf::CircleShape circle(r);
+    circle.setOrigin(r, r);
+    circle.setPosition(c.x, c.y);
     circle.setFillColor(Color(0, 0, 0, 0)); // Sin relleno
     circle.setOutlineColor(box2d2SFMLColor(color)); // Color del borde
 
@@ -53,9 +57,11 @@ void SFMLRenderer::DrawCircle(const b2Vec2& center, float radius, const b2Color&
 // Dibuja un crculo con relleno
 void SFMLRenderer::DrawSolidCircle(const b2Vec2& center, float radius, const b2Vec2& axis, const b2Color& color)
 {
-    sf::CircleShape circle(radius);
-    circle.setOrigin(radius, radius);
-    circle.setPosition(center.x, center.y);
+    float r = WorldUnits::ToUnits(radius);
+    b2Vec2 c = WorldUnits::ToUnits(center);
+    sf::CircleShape circle(r);
+    circle.setOrigin(r, r);
+    circle.setPosition(c.x, c.y);
     circle.setFillColor(box2d2SFMLColor(color)); // Establece el color de relleno
     circle.setOutlineColor(box2d2SFMLColor(color)); // Color del borde
 
@@ -65,10 +71,12 @@ void SFMLRenderer::DrawSolidCircle(const b2Vec2& center, float radius, const b2V
 // Dibuja un segmento
 void SFMLRenderer::DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color& color)
 {
+    b2Vec2 a = WorldUnits::ToUnits(p1);
+    b2Vec2 b = WorldUnits::ToUnits(p2);
     sf::Vertex line[] =
     {
-        sf::Vertex(sf::Vector2f(p1.x, p1.y), box2d2SFMLColor(color)),
-        sf::Vertex(sf::Vector2f(p2.x, p2.y), box2d2SFMLColor(color))
+        sf::Vertex(sf::Vector2f(a.x, a.y), box2d2SFMLColor(color)),
+        sf::Vertex(sf::Vector2f(b.x, b.y), box2d2SFMLColor(color))
     };
 
     wnd->draw(line, 2, sf::Lines); // Dibuja el segmento en la ventana
@@ -78,7 +86,7 @@ void SFMLRenderer::DrawSegment(const b2Vec2& p1, const b2Vec2& p2, const b2Color
 void SFMLRenderer::DrawTransform(const b2Transform& xf)
 {
     // Dibuja los ejes de la transformacin
-    b2Vec2 p1 = xf.p, p2;
+    b2Vec2 p1 = WorldUnits::ToUnits(xf.p), p2;
     const float k_axisScale = 20.0f;
     p2 = p1 + k_axisScale * xf.q.GetXAxis();
 
@@ -105,7 +113,7 @@ void SFMLRenderer::DrawPoint(const b2Vec2& p, float size, const b2Color& color)
     const float radius = 0.5f; // Radio del punto
     sf::CircleShape circle(radius);
     circle.setOrigin(radius, radius);
-    circle.setPosition(p.x, p.y);
+    circle.setPosition(WorldUnits::ToUnits(p.x), WorldUnits::ToUnits(p.y));
     circle.setFillColor(box2d2SFMLColor(color)); // Color del punto
     circle.setOutlineColor(box2d2SFMLColor(color)); // Color del borde
 
@@ -126,10 +134,10 @@ void SFMLRenderer::DrawString(int x, int y, const char* string, ...)
 // Dibuja un AABB (Axis-Aligned Bounding Box)
 void SFMLRenderer::DrawAABB(b2AABB* aabb, const b2Color& color)
 {
-    const auto halfSize = aabb->GetExtents();
+    const auto halfSize = WorldUnits::ToUnits(aabb->GetExtents());
     sf::RectangleShape rectangle(sf::Vector2f(halfSize.x, halfSize.y) * 2.0f);
     rectangle.setOrigin(halfSize.x, halfSize.y);
-    const auto center = aabb->GetCenter();
+    const auto center = WorldUnits::ToUnits(aabb->GetCenter());
     rectangle.setPosition(center.x, center.y);
     rectangle.setFillColor(Color(0, 0, 0, 0)); // Sin relleno
     rectangle.setOutlineColor(box2d2SFMLColor(color)); // Color del borde
@@ -137,6 +145,154 @@ void SFMLRenderer::DrawAABB(b2AABB* aabb, const b2Color& color)
     wnd->draw(rectangle); // Dibuja el AABB en la ventana
 }
 
+// Acumula todos los fixtures que toca la consulta
+bool SFMLRenderer::VisibleQuery::ReportFixture(b2Fixture* fixture)
+{
+    fixtures.push_back(fixture);
+    return true;
+}
+
+// Rectngulo de la vista sin rotacin, agrandado en margin
+b2AABB SFMLRenderer::GetViewBounds(float margin) const
+{
+    const View& view = wnd->getView();
+    Vector2f half(fabsf(view.getSize().x) * 0.5f + margin, fabsf(view.getSize().y) * 0.5f + margin);
+    Vector2f center = view.getCenter();
+
+    b2AABB bounds;
+    bounds.lowerBound = WorldUnits::ToMeters(b2Vec2(center.x - half.x, center.y - half.y));
+    bounds.upperBound = WorldUnits::ToMeters(b2Vec2(center.x + half.x, center.y + half.y));
+    return bounds;
+}
+
+// Mismo orden y colores que b2World::DebugDraw, pero sobre lo que devuelve QueryAABB
+void SFMLRenderer::DrawWorld(b2World* world, float margin)
+{
+    uint32 flags = GetFlags();
+    b2AABB bounds = GetViewBounds(margin);
+
+    // Un fixture de cadena aparece una vez por cada hijo: se dejan sin repetir
+    visible.fixtures.clear();
+    world->QueryAABB(&visible, bounds);
+    std::sort(visible.fixtures.begin(), visible.fixtures.end());
+    visible.fixtures.erase(std::unique(visible.fixtures.begin(), visible.fixtures.end()), visible.fixtures.end());
+
+    if (flags & e_shapeBit)
+    {
+        for (b2Fixture* f : visible.fixtures)
+        {
+            b2Body* body = f->GetBody();
+            DrawFixture(f, body->GetTransform(), BodyColor(body));
+        }
+    }
+
+    if (flags & e_jointBit)
+    {
+        // Un joint se dibuja si alguno de sus anclajes est en la vista
+        for (b2Joint* j = world->GetJointList(); j; j = j->GetNext())
+        {
+            b2Vec2 a = j->GetAnchorA();
+            b2Vec2 b = j->GetAnchorB();
+            bool inA = a.x >= bounds.lowerBound.x && a.x <= bounds.upperBound.x && a.y >= bounds.lowerBound.y && a.y <= bounds.upperBound.y;
+            bool inB = b.x >= bounds.lowerBound.x && b.x <= bounds.upperBound.x && b.y >= bounds.lowerBound.y && b.y <= bounds.upperBound.y;
+            if (inA || inB)
+                j->Draw(this);
+        }
+    }
+
+    if (flags & e_aabbBit)
+    {
+        b2Color color(0.9f, 0.3f, 0.9f);
+        for (b2Fixture* f : visible.fixtures)
+        {
+            for (int32 i = 0; i < f->GetShape()->GetChildCount(); ++i)
+            {
+                const b2AABB& aabb = f->GetAABB(i);
+                b2Vec2 vs[4];
+                vs[0].Set(aabb.lowerBound.x, aabb.lowerBound.y);
+                vs[1].Set(aabb.upperBound.x, aabb.lowerBound.y);
+                vs[2].Set(aabb.upperBound.x, aabb.upperBound.y);
+                vs[3].Set(aabb.lowerBound.x, aabb.upperBound.y);
+                DrawPolygon(vs, 4, color);
+            }
+        }
+    }
+
+    if (flags & e_centerOfMassBit)
+    {
+        visibleBodies.clear();
+        for (b2Fixture* f : visible.fixtures)
+            visibleBodies.push_back(f->GetBody());
+        std::sort(visibleBodies.begin(), visibleBodies.end());
+        visibleBodies.erase(std::unique(visibleBodies.begin(), visibleBodies.end()), visibleBodies.end());
+
+        for (b2Body* body : visibleBodies)
+        {
+            b2Transform xf = body->GetTransform();
+            xf.p = body->GetWorldCenter();
+            DrawTransform(xf);
+        }
+    }
+}
+
+// Color de los shapes segn el estado del body (como b2World::DebugDraw)
+b2Color SFMLRenderer::BodyColor(const b2Body* body)
+{
+    if (!body->IsEnabled())
+        return b2Color(0.5f, 0.5f, 0.3f);
+    if (body->GetType() == b2_staticBody)
+        return b2Color(0.5f, 0.9f, 0.5f);
+    if (body->GetType() == b2_kinematicBody)
+        return b2Color(0.5f, 0.5f, 0.9f);
+    if (!body->IsAwake())
+        return b2Color(0.6f, 0.6f, 0.6f);
+    return b2Color(0.9f, 0.7f, 0.7f);
+}
+
+// Dibuja un fixture con la transformacin de su body (copia de b2World::DrawShape, que es privado)
+void SFMLRenderer::DrawFixture(b2Fixture* fixture, const b2Transform& xf, const b2Color& color)
+{
+    switch (fixture->GetType())
+    {
+    case b2Shape::e_circle:
+    {
+        b2CircleShape* circle = (b2CircleShape*)fixture->GetShape();
+        b2Vec2 center = b2Mul(xf, circle->m_p);
+        b2Vec2 axis = b2Mul(xf.q, b2Vec2(1.0f, 0.0f));
+        DrawSolidCircle(center, circle->m_radius, axis, color);
+    }
+    break;
+
+    case b2Shape::e_edge:
+    {
+        b2EdgeShape* edge = (b2EdgeShape*)fixture->GetShape();
+        DrawSegment(b2Mul(xf, edge->m_vertex1), b2Mul(xf, edge->m_vertex2), color);
+    }
+    break;
+
+    case b2Shape::e_chain:
+    {
+        b2ChainShape* chain = (b2ChainShape*)fixture->GetShape();
+        for (int32 i = 1; i < chain->m_count; ++i)
+            DrawSegment(b2Mul(xf, chain->m_vertices[i - 1]), b2Mul(xf, chain->m_vertices[i]), color);
+    }
+    break;
+
+    case b2Shape::e_polygon:
+    {
+        b2PolygonShape* poly = (b2PolygonShape*)fixture->GetShape();
+        b2Vec2 vertices[b2_maxPolygonVertices];
+        for (int32 i = 0; i < poly->m_count; ++i)
+            vertices[i] = b2Mul(xf, poly->m_vertices[i]);
+        DrawSolidPolygon(vertices, poly->m_count, color);
+    }
+    break;
+
+    default:
+        break;
+    }
+}
+
 // Convierte un color de Box2D a un color de SFML
 Color SFMLRenderer::box2d2SFMLColor(const b2Color& _color)
 {
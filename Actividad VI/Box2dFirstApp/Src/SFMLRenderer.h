@@ -1,11 +1,17 @@
 //-----------------------------------------------------
 //Clase utilitaria que provee los callbacks requeridos 
-//por SFML para dibujar los objetos que esta simulando
+//por SFML para dibujar los objetos que esta simulando.
+//DrawWorld reemplaza a b2World::DebugDraw: consulta el
+//rbol del broadphase con el rectngulo de la vista (ms
+//un margen) y dibuja solo los fixtures, joints y AABBs
+//que caen ah, as el costo depende de lo que se ve y
+//no del tamao del mundo
 //-----------------------------------------------------
 
 #pragma once
 #include <Box2D/Box2D.h>
 #include <SFML\Graphics.hpp>
+#include <vector>
 
 using namespace sf;
 
@@ -14,6 +20,18 @@ class SFMLRenderer : public b2Draw//b2DebugDraw
 private:
 	RenderWindow *wnd;
 
+	// Fixtures que devuelve la consulta de la vista (se reusa entre frames)
+	struct VisibleQuery : public b2QueryCallback
+	{
+		std::vector<b2Fixture*> fixtures;
+		bool ReportFixture(b2Fixture* fixture) override;
+	};
+	VisibleQuery visible;
+	std::vector<b2Body*> visibleBodies;
+
+	void DrawFixture(b2Fixture* fixture, const b2Transform& xf, const b2Color& color);
+	static b2Color BodyColor(const b2Body* body);
+
 public:
 	SFMLRenderer(RenderWindow *window);
 	~SFMLRenderer(void);
@@ -28,4 +46,10 @@ public:
 	void DrawPoint(const b2Vec2& p, float size, const b2Color& color) override;
 	void DrawString(int x, int y, const char* string, ...);
 	void DrawAABB(b2AABB* aabb, const b2Color& color);
+
+	// Rectngulo de la vista actual agrandado en margin unidades de render, en metros
+	b2AABB GetViewBounds(float margin) const;
+
+	// Dibuja con los flags actuales solo lo que est dentro de la vista ms margin
+	void DrawWorld(b2World* world, float margin = 10.0f);
 };
\ No newline at end of file
@@ -0,0 +1,67 @@
+//-----------------------------------------------------
+//Cola circular sin locks para un solo productor y un
+//solo consumidor. El productor solo escribe tail y el
+//consumidor solo escribe head, as alcanza con atomics
+//con orden acquire/release. La capacidad es fija y se
+//reserva al construir: Push falla si la cola est llena
+//-----------------------------------------------------
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+
+template<typename T, size_t Capacity>
+class SpscQueue
+{
+private:
+	// Un lugar queda siempre libre para distinguir llena de vaca
+	T items[Capacity + 1];
+	std::atomic<size_t> head;
+	std::atomic<size_t> tail;
+
+	static size_t Next(size_t index)
+	{
+		return index == Capacity ? 0 : index + 1;
+	}
+
+public:
+	SpscQueue(void)
+	{
+		head = 0;
+		tail = 0;
+	}
+
+	//-------------------------------------------------------------
+	// Solo desde el hilo productor
+	//-------------------------------------------------------------
+	bool Push(const T& item)
+	{
+		size_t t = tail.load(std::memory_order_relaxed);
+		size_t next = Next(t);
+		if (next == head.load(std::memory_order_acquire))
+			return false;
+
+		items[t] = item;
+		tail.store(next, std::memory_order_release);
+		return true;
+	}
+
+	//-------------------------------------------------------------
+	// Solo desde el hilo consumidor
+	//-------------------------------------------------------------
+	bool Pop(T& item)
+	{
+		size_t h = head.load(std::memory_order_relaxed);
+		if (h == tail.load(std::memory_order_acquire))
+			return false;
+
+		item = items[h];
+		head.store(Next(h), std::memory_order_release);
+		return true;
+	}
+
+	bool IsEmpty() const
+	{
+		return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+	}
+};
@@ -0,0 +1,106 @@
+#include "TeleportBatch.h"
+#include "BodyIndex.h"
+#include "WorldUnits.h"
+#include <algorithm>
+
+TeleportBatch::TeleportBatch(int capacity)
+{
+    entries.reserve(capacity);
+    applied = 0;
+    skipped = 0;
+}
+
+void TeleportBatch::Teleport(b2Body* body, b2Vec2 position, float angle)
+{
+    Add(body, WorldUnits::ToMeters(position), angle, b2Vec2_zero, false);
+}
+
+void TeleportBatch::Teleport(b2Body* body, b2Vec2 position, float angle, b2Vec2 velocity)
+{
+    Add(body, WorldUnits::ToMeters(position), angle, WorldUnits::ToMeters(velocity), true);
+}
+
+void TeleportBatch::Add(b2Body* body, b2Vec2 position, float angle, b2Vec2 velocity, bool setVelocity)
+{
+    Entry entry;
+    entry.body = body;
+    entry.position = position;
+    entry.angle = angle;
+    entry.velocity = velocity;
+    entry.setVelocity = setVelocity;
+    entry.order = (int)entries.size();
+    entry.key = 0;
+    entries.push_back(entry);
+}
+
+void TeleportBatch::Cancel(b2Body* body)
+{
+    entries.erase(std::remove_if(entries.begin(), entries.end(), [body](const Entry& entry)
+    {
+        return entry.body == body;
+    }), entries.end());
+}
+
+int TeleportBatch::Apply()
+{
+    if (entries.empty())
+        return 0;
+
+    // El ltimo destino de cada body: ordenados por body y llegada, se queda el ltimo de cada tramo
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b)
+    {
+        return a.body != b.body ? a.body < b.body : a.order < b.order;
+    });
+    size_t kept = 0;
+    for (size_t i = 0; i < entries.size(); i++)
+    {
+        if (i + 1 < entries.size() && entries[i + 1].body == entries[i].body)
+            continue;
+        entries[kept++] = entries[i];
+    }
+    skipped += (int)(entries.size() - kept);
+    entries.resize(kept);
+
+    // Curva Z de los destinos dentro de la caja que los contiene
+    b2AABB bounds;
+    bounds.lowerBound = entries[0].position;
+    bounds.upperBound = entries[0].position;
+    for (const Entry& entry : entries)
+    {
+        bounds.lowerBound = b2Min(bounds.lowerBound, entry.position);
+        bounds.upperBound = b2Max(bounds.upperBound, entry.position);
+    }
+    for (Entry& entry : entries)
+        entry.key = BodyIndex::MortonCode(entry.position.x, entry.position.y, bounds);
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b)
+    {
+        return a.key < b.key;
+    });
+
+    int count = 0;
+    for (const Entry& entry : entries)
+    {
+        b2Body* body = entry.body;
+
+        // Ya est en el destino: SetTransform solo movera los proxies sin cambiarlos
+        if (body->GetPosition() != entry.position || body->GetAngle() != entry.angle)
+        {
+            body->SetTransform(entry.position, entry.angle);
+            count++;
+        }
+        else
+            skipped++;
+
+        if (entry.setVelocity)
+        {
+            body->SetLinearVelocity(entry.velocity);
+            body->SetAngularVelocity(0.0f);
+        }
+        if (body->GetType() != b2_staticBody)
+            body->SetAwake(true);
+    }
+
+    applied += count;
+    entries.clear();
+    return count;
+}
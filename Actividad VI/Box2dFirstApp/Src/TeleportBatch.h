@@ -0,0 +1,61 @@
+//-----------------------------------------------------
+//Teletransportes diferidos. b2Body::SetTransform mueve
+//en el momento cada proxy de los fixtures del body, as
+//que reubicar muchos bodies (reinicio del nivel, una
+//oleada que reaparece) paga ese costo por llamada y dos
+//veces si el mismo body se mueve dos veces en el frame.
+//Teleport solo anota el destino; Apply, justo antes del
+//prximo Step, deja el ltimo destino de cada body,
+//saltea los que ya estn ah y llama a SetTransform una
+//vez por body en orden de curva Z de los destinos, as
+//las reinserciones seguidas tocan la misma zona del
+//rbol del broadphase
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <vector>
+
+class TeleportBatch
+{
+private:
+	struct Entry
+	{
+		b2Body* body;
+		b2Vec2 position;		// en metros
+		float angle;
+		b2Vec2 velocity;		// en metros, solo si setVelocity
+		bool setVelocity;
+		int order;				// orden de llegada (gana el ltimo por body)
+		uint32 key;				// cdigo de Morton del destino
+	};
+
+	std::vector<Entry> entries;
+	int applied;
+	int skipped;
+
+	void Add(b2Body* body, b2Vec2 position, float angle, b2Vec2 velocity, bool setVelocity);
+
+public:
+	TeleportBatch(int capacity = 256);
+
+	// Anota el destino del body (position en unidades de render). Conserva su velocidad
+	void Teleport(b2Body* body, b2Vec2 position, float angle);
+
+	// Anota el destino y la velocidad con la que sale de ah (en unidades de render)
+	void Teleport(b2Body* body, b2Vec2 position, float angle, b2Vec2 velocity);
+
+	// Descarta los destinos anotados para el body (se llama antes de destruirlo)
+	void Cancel(b2Body* body);
+
+	// Aplica los destinos anotados. No se puede llamar durante Step.
+	// Devuelve cuntos SetTransform hizo
+	int Apply();
+
+	int GetPendingCount() const { return (int)entries.size(); }
+
+	// Totales desde la creacin: SetTransform hechos y destinos descartados
+	// (repetidos o iguales a la posicin actual)
+	int GetAppliedCount() const { return applied; }
+	int GetSkippedCount() const { return skipped; }
+};
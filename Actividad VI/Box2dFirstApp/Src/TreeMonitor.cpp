@@ -0,0 +1,192 @@
+#include "TreeMonitor.h"
+#include "BodyIndex.h"
+#include <cmath>
+
+// Mximo de muestras de espera despus de reconstrucciones que no sirvieron
+#define TREE_MAX_BACKOFF 64
+
+// Constructor: sin reconstruccin en curso
+TreeMonitor::TreeMonitor(b2World* world, int sampleInterval, float qualityThreshold)
+{
+    this->world = world;
+    this->sampleInterval = sampleInterval > 0 ? sampleInterval : 1;
+    this->qualityThreshold = qualityThreshold;
+    stepCounter = 0;
+    batchSize = 32;
+    pendingIndex = 0;
+    rebuildMs = 0.0f;
+    rebuildFrames = 0;
+    reinserted = 0;
+    skipped = 0;
+    cooldown = 0;
+    backoff = 0;
+    rebuildCount = 0;
+    totalRebuildMs = 0.0f;
+    lastRebuildMs = 0.0f;
+    stats = Measure();
+    statsBefore = stats;
+}
+
+// Cada cuntos pasos se miden las mtricas
+void TreeMonitor::SetSampleInterval(int steps)
+{
+    sampleInterval = steps > 0 ? steps : 1;
+}
+
+// Calidad a partir de la cual se reconstruye
+void TreeMonitor::SetQualityThreshold(float quality)
+{
+    qualityThreshold = quality;
+}
+
+// Mximo de bodies reinsertados por frame
+void TreeMonitor::SetBatchSize(int bodies)
+{
+    batchSize = bodies > 0 ? bodies : 1;
+}
+
+// Lee las mtricas del rbol desde el mundo
+TreeStats TreeMonitor::Measure() const
+{
+    TreeStats s;
+    s.height = world->GetTreeHeight();
+    s.balance = world->GetTreeBalance();
+    s.quality = world->GetTreeQuality();
+    s.proxyCount = world->GetProxyCount();
+    return s;
+}
+
+// La calidad es el rea total de los nodos sobre el rea de la raz: crece
+// cuando los nodos internos se solapan. Tambin se controla que la altura
+// no supere el doble de la de un rbol balanceado
+bool TreeMonitor::NeedsRebuild() const
+{
+    if (stats.proxyCount < 2)
+        return false;
+    if (stats.quality > qualityThreshold)
+        return true;
+
+    int balancedHeight = (int)ceilf(log2f((float)stats.proxyCount));
+    return stats.height > 2 * balancedHeight + 2;
+}
+
+// Mide cada sampleInterval pasos y avanza la reconstruccin con el tiempo libre
+void TreeMonitor::AfterStep(float idleMs)
+{
+    if (++stepCounter >= sampleInterval)
+    {
+        stepCounter = 0;
+        stats = Measure();
+        if (cooldown > 0)
+            cooldown--;
+        else if (!IsRebuilding() && NeedsRebuild())
+            BeginRebuild();
+    }
+
+    if (IsRebuilding() && idleMs > 0.0f)
+        ContinueRebuild(idleMs);
+}
+
+// Junta los bodies a reinsertar; el trabajo se hace en ContinueRebuild.
+// Los estticos no se tocan: deshabilitar el suelo destruira todos sus contactos
+void TreeMonitor::BeginRebuild()
+{
+    pending.clear();
+    for (b2Body* body = world->GetBodyList(); body; body = body->GetNext())
+    {
+        if (body->GetType() != b2_staticBody && body->IsEnabled() && body->GetFixtureList() != nullptr)
+            pending.push_back(body);
+    }
+    // Se reinserta en orden de curva Z: los nodos nuevos del rbol salen de la
+    // lista libre en ese orden y los vecinos en el espacio quedan cerca en memoria
+    BodyIndex::SortMorton(pending);
+    pendingIndex = 0;
+    statsBefore = stats;
+    rebuildMs = 0.0f;
+    rebuildFrames = 0;
+    reinserted = 0;
+    skipped = 0;
+}
+
+// La lista de contactos del body tambin tiene los pares cuyos AABB engordados
+// se solapan sin tocarse; esos se pueden perder, box2d los vuelve a crear
+static bool IsTouching(b2Body* body)
+{
+    for (b2ContactEdge* edge = body->GetContactList(); edge; edge = edge->next)
+    {
+        if (edge->contact->IsTouching())
+            return true;
+    }
+    return false;
+}
+
+// Reinserta lotes de bodies hasta agotar el tiempo disponible
+void TreeMonitor::ContinueRebuild(float budgetMs)
+{
+    b2Timer timer;
+    rebuildFrames++;
+
+    while (IsRebuilding() && timer.GetMilliseconds() < budgetMs)
+    {
+        size_t end = b2Min(pendingIndex + (size_t)batchSize, pending.size());
+
+        // Primero se quitan todos los proxies del lote y despus se vuelven a
+        // insertar, as cada insercin ve un rbol sin los nodos viejos.
+        // Los bodies que estn tocando algo se saltean para no perder eventos ni el warm starting
+        for (size_t i = pendingIndex; i < end; i++)
+        {
+            if (pending[i] == nullptr)
+                continue;
+            if (IsTouching(pending[i]))
+            {
+                pending[i] = nullptr;
+                skipped++;
+            }
+            else
+                pending[i]->SetEnabled(false);
+        }
+        for (size_t i = pendingIndex; i < end; i++)
+        {
+            if (pending[i] != nullptr)
+            {
+                pending[i]->SetEnabled(true);
+                reinserted++;
+            }
+        }
+        pendingIndex = end;
+    }
+
+    rebuildMs += timer.GetMilliseconds();
+    if (!IsRebuilding())
+        EndRebuild();
+}
+
+// Guarda el costo de la reconstruccin; Benchmark::RunTreeMonitor lo muestra.
+// Si la calidad no baj (casi todos los bodies se saltearon) se duplica la
+// espera antes del prximo intento
+void TreeMonitor::EndRebuild()
+{
+    pending.clear();
+    pendingIndex = 0;
+    stats = Measure();
+
+    rebuildCount++;
+    lastRebuildMs = rebuildMs;
+    totalRebuildMs += rebuildMs;
+
+    if (stats.quality < statsBefore.quality)
+        backoff = 0;
+    else
+        backoff = b2Min(backoff > 0 ? 2 * backoff : 1, TREE_MAX_BACKOFF);
+    cooldown = backoff;
+}
+
+// Saca un body de la reconstruccin en curso antes de que se destruya
+void TreeMonitor::Forget(b2Body* body)
+{
+    for (size_t i = pendingIndex; i < pending.size(); i++)
+    {
+        if (pending[i] == body)
+            pending[i] = nullptr;
+    }
+}
@@ -0,0 +1,97 @@
+//-----------------------------------------------------
+//Monitor de calidad del rbol del broadphase. Cada N
+//pasos mide la altura, el balance y la calidad del
+//b2DynamicTree (b2World::GetTreeHeight/Balance/Quality)
+//y, si la calidad se degrad, reinserta los bodies en
+//lotes repartidos entre frames con tiempo libre. La
+//reinsercin se hace deshabilitando y habilitando el
+//body, que quita y vuelve a insertar sus proxies (solo
+//bodies no estticos y sin contactos tocndose); el
+//b2DynamicTree del mundo es privado y no se puede
+//llamar a RebuildBottomUp desde afuera de box2d. Los
+//bodies se reinsertan ordenados por curva Z. Si una
+//reconstruccin no baja la calidad se espera cada vez
+//ms muestras antes de volver a intentar
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <vector>
+
+// Mtricas del rbol en un momento dado
+struct TreeStats
+{
+	int height;
+	int balance;
+	float quality;
+	int proxyCount;
+};
+
+class TreeMonitor
+{
+private:
+	b2World* world;
+
+	// Cada cuntos pasos se miden las mtricas
+	int sampleInterval;
+	int stepCounter;
+
+	// Calidad a partir de la cual se reconstruye
+	float qualityThreshold;
+
+	// Mximo de bodies reinsertados por frame
+	int batchSize;
+
+	// ltima medicin
+	TreeStats stats;
+
+	// Reconstruccin en curso
+	std::vector<b2Body*> pending;
+	size_t pendingIndex;
+	TreeStats statsBefore;
+	float rebuildMs;
+	int rebuildFrames;
+	int reinserted;
+	int skipped;
+
+	// Muestras que faltan para poder volver a reconstruir y espera actual
+	int cooldown;
+	int backoff;
+
+	// Totales
+	int rebuildCount;
+	float totalRebuildMs;
+	float lastRebuildMs;
+
+	TreeStats Measure() const;
+	bool NeedsRebuild() const;
+	void BeginRebuild();
+	void ContinueRebuild(float budgetMs);
+	void EndRebuild();
+
+public:
+	TreeMonitor(b2World* world, int sampleInterval, float qualityThreshold);
+
+	void SetSampleInterval(int steps);
+	void SetQualityThreshold(float quality);
+	void SetBatchSize(int bodies);
+
+	// Se llama despus de cada Step con el tiempo libre que queda en el frame.
+	// Si no hay tiempo libre la reconstruccin espera al prximo frame ocioso
+	void AfterStep(float idleMs);
+
+	// Se debe llamar antes de destruir un body mientras hay una reconstruccin en curso
+	void Forget(b2Body* body);
+
+	bool IsRebuilding() const { return pendingIndex < pending.size(); }
+	const TreeStats& GetStats() const { return stats; }
+
+	// Datos de la ltima reconstruccin terminada
+	const TreeStats& GetStatsBeforeRebuild() const { return statsBefore; }
+	int GetLastReinserted() const { return reinserted; }
+	int GetLastSkipped() const { return skipped; }
+	int GetLastRebuildFrames() const { return rebuildFrames; }
+	int GetRebuildCount() const { return rebuildCount; }
+	float GetLastRebuildMs() const { return lastRebuildMs; }
+	float GetTotalRebuildMs() const { return totalRebuildMs; }
+};
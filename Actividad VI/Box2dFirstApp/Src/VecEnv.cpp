@@ -0,0 +1,158 @@
+#include "VecEnv.h"
+#include "Game.h"
+#include "WorldUnits.h"
+#include <iostream>
+
+// Mximo de disparos en vuelo por mundo
+#define ENV_MAX_BALLISTIC 64
+
+// Constructor: crea los mundos y escribe la primera observacin
+VecEnv::VecEnv(int count, float* buffer, int threadCount)
+{
+    envs.resize(count);
+    for (Env& env : envs)
+    {
+        env.world = nullptr;
+        env.control = nullptr;
+        env.ballistic = nullptr;
+        env.hits = 0;
+    }
+
+    if (buffer != nullptr)
+        observations = buffer;
+    else
+    {
+        ownedObservations.resize(count * OBS_SIZE);
+        observations = ownedObservations.data();
+    }
+
+    jobs = threadCount == 1 ? nullptr : new JobSystem(threadCount);
+    timeStep = 1.0f / 60.0f;
+    Reset();
+}
+
+// Destructor: libera los mundos (el buffer externo no es nuestro)
+VecEnv::~VecEnv(void)
+{
+    for (Env& env : envs)
+    {
+        delete env.ballistic;
+        delete env.world;
+    }
+    delete jobs;
+}
+
+// Crea el mundo index desde cero con la escena del juego
+void VecEnv::Build(int index)
+{
+    Env& env = envs[index];
+    delete env.ballistic;
+    delete env.world;
+    env.world = new b2World(b2Vec2(0.0f, 0.0f));
+    env.control = Game::BuildScene(env.world);
+    env.ballistic = new BallisticProjectiles(env.world, 2.0f, LAYER_PROJECTILE, ENV_MAX_BALLISTIC);
+    env.projectiles.clear();
+    env.hits = 0;
+}
+
+// Escribe el estado del lanzador y de sus disparos en su lugar del buffer
+void VecEnv::Observe(int index)
+{
+    const Env& env = envs[index];
+    float* obs = observations + index * OBS_SIZE;
+
+    obs[OBS_Y] = env.control->GetPosition().y;
+    obs[OBS_VY] = env.control->GetLinearVelocity().y;
+    obs[OBS_SHOTS] = (float)(env.ballistic->GetCount() + env.projectiles.size());
+    obs[OBS_HITS] = (float)env.hits;
+}
+
+void VecEnv::Reset()
+{
+    for (int i = 0; i < GetCount(); i++)
+        Reset(i);
+}
+
+void VecEnv::Reset(int index)
+{
+    Build(index);
+    Observe(index);
+}
+
+// Los mundos de [begin, end) no comparten nada, se pueden simular en cualquier hilo.
+// Despus del Step se hace lo mismo que el juego con los disparos: avanzan sin
+// body, reciben uno al chocar y se destruyen al salir de la escena
+void VecEnv::StepRange(const uint32* actions, int begin, int end)
+{
+    for (int i = begin; i < end; i++)
+    {
+        Env& env = envs[i];
+        Game::ApplyAction(env.control, env.ballistic, actions[i]);
+        env.world->Step(timeStep, 8, 3);
+        env.world->ClearForces();
+
+        env.ballistic->RemoveBeyond(800.0f);
+        env.ballistic->Step(timeStep);
+        env.hits = env.ballistic->Promote(2.0f, 1.0f, 0.5f, env.projectiles);
+
+        float limit = WorldUnits::ToMeters(800.0f);
+        for (size_t k = 0; k < env.projectiles.size(); )
+        {
+            if (env.projectiles[k]->GetPosition().x > limit)
+            {
+                env.world->DestroyBody(env.projectiles[k]);
+                env.projectiles[k] = env.projectiles.back();
+                env.projectiles.pop_back();
+            }
+            else
+                k++;
+        }
+        Observe(i);
+    }
+}
+
+void VecEnv::Step(const uint32* actions)
+{
+    if (jobs == nullptr)
+    {
+        StepRange(actions, 0, GetCount());
+        return;
+    }
+
+    // Bloques de 16 mundos: suficiente trabajo por tarea y margen para repartir
+    jobs->ParallelFor(GetCount(), 16, [this, actions](int begin, int end)
+    {
+        StepRange(actions, begin, end);
+    });
+}
+
+// Corre el mismo nmero de pasos en un hilo y en todos los ncleos
+void VecEnv::RunThroughput(int count, int steps)
+{
+    std::vector<uint32> actions(count);
+    const uint32 mask = INPUT_UP | INPUT_DOWN | INPUT_FIRE;
+
+    const int threadCounts[] = { 1, 0 };
+    for (int threads : threadCounts)
+    {
+        VecEnv env(count, nullptr, threads);
+        unsigned int seed = 12345;
+        b2Timer timer;
+
+        for (int step = 0; step < steps; step++)
+        {
+            // Acciones al azar con un generador congruencial (igual en las dos corridas)
+            for (int i = 0; i < count; i++)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                actions[i] = (seed >> 16) & mask;
+            }
+            env.Step(actions.data());
+        }
+
+        float seconds = timer.GetMilliseconds() / 1000.0f;
+        std::cout << count << " mundos x " << steps << " pasos, "
+            << (threads == 1 ? "1 hilo" : "todos los hilos") << ": "
+            << (int)(count * steps / seconds) << " pasos de entorno/s" << std::endl;
+    }
+}
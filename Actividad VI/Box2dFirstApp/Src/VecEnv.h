@@ -0,0 +1,74 @@
+//-----------------------------------------------------
+//Entorno vectorizado para entrenar controladores del
+//lanzador sin ventana. Mantiene N mundos con la escena
+//de la actividad (Game::BuildScene) y sus disparos sin
+//body, aplica una mscara de InputAction por mundo en
+//cada paso (Game::ApplyAction, lo mismo que el teclado)
+//y escribe el estado de cada mundo en un nico buffer de
+//floats contiguo. El buffer puede ser de quien lo usa
+//(por ejemplo memoria compartida con un entrenador
+//externo): los mundos escriben directamente ah
+//-----------------------------------------------------
+
+#pragma once
+#include <Box2D/Box2D.h>
+#include <vector>
+#include "JobSystem.h"
+#include "BallisticProjectiles.h"
+
+// ndices de cada dato dentro de la observacin de un mundo (en metros, de box2d)
+enum ObservationField
+{
+	OBS_Y = 0,			// el lanzador solo se mueve en y
+	OBS_VY,
+	OBS_SHOTS,			// disparos en vuelo y proyectiles con body vivos
+	OBS_HITS,			// disparos que chocaron en el ltimo paso
+	OBS_SIZE
+};
+
+class VecEnv
+{
+private:
+	// Un mundo del entorno
+	struct Env
+	{
+		b2World* world;
+		b2Body* control;
+		BallisticProjectiles* ballistic;
+		std::vector<b2Body*> projectiles;	// disparos que recibieron body al chocar
+		int hits;
+	};
+
+	std::vector<Env> envs;
+
+	// Observaciones: OBS_SIZE floats por mundo, uno detrs de otro
+	float* observations;
+	std::vector<float> ownedObservations;
+
+	JobSystem* jobs;
+	float timeStep;
+
+	void Build(int index);
+	void Observe(int index);
+	void StepRange(const uint32* actions, int begin, int end);
+
+public:
+	// buffer (opcional) debe tener lugar para count * OBS_SIZE floats y vivir ms que el entorno.
+	// threadCount como en JobSystem; 1 corre todo en el hilo que llama
+	VecEnv(int count, float* buffer = nullptr, int threadCount = 0);
+	~VecEnv(void);
+
+	// Vuelve a crear todos los mundos, o uno solo (fin de episodio)
+	void Reset();
+	void Reset(int index);
+
+	// Aplica actions[i] (INPUT_UP, INPUT_DOWN, INPUT_FIRE) al mundo i y avanza todos un paso de 1/60 s
+	void Step(const uint32* actions);
+
+	const float* GetObservations() const { return observations; }
+	const float* GetObservation(int index) const { return observations + index * OBS_SIZE; }
+	int GetCount() const { return (int)envs.size(); }
+
+	// Mide pasos de entorno por segundo con acciones al azar, en un hilo y en todos
+	static void RunThroughput(int count, int steps);
+};